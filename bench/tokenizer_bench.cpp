@@ -0,0 +1,132 @@
+#include "rng.h"
+#include "tokenizer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Compares Tokenizer with the stringstream splitting it replaced, on one generated corpus
+// of typed commands (lowercased, then split on spaces) and log messages (split on spaces,
+// as WrapText does). Both sides must produce the same tokens; the run fails otherwise.
+//   tokenizer_bench [lines] [rounds]
+
+// The SplitString and ToLower that Tokenizer replaced, kept here as the baseline
+static std::vector<std::string> SplitString(const std::string& str, char delimiter) {
+    std::vector<std::string> tokens;
+    std::stringstream ss(str);
+    std::string token;
+    
+    while (std::getline(ss, token, delimiter)) {
+        if (!token.empty()) {
+            tokens.push_back(token);
+        }
+    }
+    return tokens;
+}
+
+static std::string ToLower(const std::string& str) {
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    return result;
+}
+
+static const char* const VERBS[] = {"go", "take", "equip", "drop", "use", "stats", "look", "inventory", "combine", "map", "Go", "TAKE"};
+static const char* const NOUNS[] = {"north", "south", "east", "west", "sword", "Healing Potion", "old book", "staff part", "iron key", "ROBE"};
+static const char* const WORDS[] = {"You", "see", "a", "dusty", "corridor", "stretching", "into", "the", "darkness.", "Exits:",
+                                    "goblin", "attacks", "for", "12", "damage!", "torches", "flicker", "along", "wet", "stone", "walls,"};
+
+struct Corpus {
+    std::vector<std::string> commands;
+    std::vector<std::string> messages;
+};
+
+static Corpus BuildCorpus(int lines) {
+    Rng rng(2024);
+    Corpus corpus;
+    for (int i = 0; i < lines; i++) {
+        if (rng.NextInt(3) == 0) {
+            // Commands are short; some carry doubled spaces the splitters must drop
+            std::string command = VERBS[rng.NextInt(12)];
+            command += rng.NextInt(8) == 0 ? "  " : " ";
+            command += NOUNS[rng.NextInt(10)];
+            corpus.commands.push_back(command);
+        } else {
+            // Log messages run to a few dozen words, like room descriptions
+            std::string message;
+            int words = 4 + rng.NextInt(40);
+            for (int w = 0; w < words; w++) {
+                if (w > 0) message += ' ';
+                message += WORDS[rng.NextInt(21)];
+            }
+            corpus.messages.push_back(message);
+        }
+    }
+    return corpus;
+}
+
+// Runs pass rounds times and reports the best round, in nanoseconds per line
+template <typename Pass>
+static double TimeBest(int rounds, size_t lines, size_t& checksum, Pass pass) {
+    double best = 0.0;
+    for (int round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = pass();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        double perLine = elapsed.count() / (double)lines;
+        if (round == 0 || perLine < best) best = perLine;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int lines = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (lines <= 0 || rounds <= 0) {
+        std::cerr << "usage: tokenizer_bench [lines] [rounds]" << std::endl;
+        return 2;
+    }
+    
+    Corpus corpus = BuildCorpus(lines);
+    
+    // Checksums add up every token's length and first character, so a splitter that
+    // drops, merges or miscases a token doesn't match
+    size_t oldChecksum = 0;
+    double oldTime = TimeBest(rounds, (size_t)lines, oldChecksum, [&]() {
+        size_t sum = 0;
+        for (const std::string& command : corpus.commands) {
+            for (const std::string& word : SplitString(ToLower(command), ' ')) sum += word.size() * 31 + (unsigned char)word[0];
+        }
+        for (const std::string& message : corpus.messages) {
+            for (const std::string& word : SplitString(message, ' ')) sum += word.size() * 31 + (unsigned char)word[0];
+        }
+        return sum;
+    });
+    
+    Tokenizer tokenizer;
+    size_t newChecksum = 0;
+    double newTime = TimeBest(rounds, (size_t)lines, newChecksum, [&]() {
+        size_t sum = 0;
+        for (const std::string& command : corpus.commands) {
+            for (std::string_view word : tokenizer.SplitLower(command, ' ')) sum += word.size() * 31 + (unsigned char)word[0];
+        }
+        for (const std::string& message : corpus.messages) {
+            for (std::string_view word : tokenizer.Split(message, ' ')) sum += word.size() * 31 + (unsigned char)word[0];
+        }
+        return sum;
+    });
+    
+    std::cout << lines << " lines (" << corpus.commands.size() << " commands, " << corpus.messages.size() << " messages), best of " << rounds << "\n";
+    std::cout << "  stringstream + vector<string>: " << oldTime << " ns per line\n";
+    std::cout << "  Tokenizer:                     " << newTime << " ns per line\n";
+    std::cout << "  speedup:                       " << oldTime / newTime << "x" << std::endl;
+    
+    if (oldChecksum != newChecksum) {
+        std::cerr << "token mismatch: " << oldChecksum << " != " << newChecksum << std::endl;
+        return 1;
+    }
+    return 0;
+}
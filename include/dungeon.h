@@ -1,10 +1,11 @@
 #pragma once
 #include "raylib.h"
+#include "rng.h"
 #include <vector>
 
 class Dungeon {
 public:
-    Dungeon();
+    explicit Dungeon(uint64_t seed);
     
     void Generate();
     void Draw();
@@ -19,4 +20,5 @@ private:
     std::vector<std::vector<int>> map;
     Color wallColor;
     Color floorColor;
+    Rng rng;
 };
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+#include "room.h"
+#include "rng.h"
+#include <vector>
+#include <memory>
+
+// Builds "the Depths": any number of procedurally generated rooms, laid out on a grid and
+// joined by compass exits. Rooms grow outwards from the first one as a random spanning
+// tree, with a few extra doors closing loops. Each gets its own obstacles, loot and
+// monsters, tougher the further it is from the entrance.
+// The same seed and room count always give the same Depths, whatever else the game's
+// RNG has done, so a saved game can rebuild them from its seed alone.
+class DungeonGenerator {
+public:
+    // rooms[0] is the entrance; its "up" exit is left free for whoever attaches the Depths
+    static std::vector<std::unique_ptr<Room>> Generate(uint64_t seed, int roomCount);
+    
+private:
+    static std::unique_ptr<Room> CreateRoom(Rng& rng, int index, int depth);
+    static void PlaceObstacles(Rng& rng, Room& room, PixelColor color, PixelColor edgeColor);
+    static void PlaceMonsters(Rng& rng, Room& room, int depth);
+    static void PlaceLoot(Rng& rng, Room& room, int depth);
+};
\ No newline at end of file
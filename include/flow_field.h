@@ -0,0 +1,36 @@
+#pragma once
+#include "room.h"
+#include <cstdint>
+
+// Breadth-first distance map over one room's walkable tiles, out from a goal tile (the
+// player). Built once per goal, after which any number of monsters can each find their
+// next step towards the goal with a look at four neighbours, walking around props
+// instead of into them.
+class FlowField {
+public:
+    static const uint16_t UNREACHABLE = 0xFFFF;
+    
+    FlowField();
+    
+    // Rebuilds the field unless it is already the one for this room and goal tile
+    void Update(const Room& room, int goalX, int goalY);
+    
+    uint16_t GetDistance(int tileX, int tileY) const {
+        if ((unsigned)tileX >= (unsigned)WIDTH || (unsigned)tileY >= (unsigned)HEIGHT) {
+            return UNREACHABLE;
+        }
+        return distance[tileY][tileX];
+    }
+    
+    // The neighbouring tile one step closer to the goal, preferring the axis the goal
+    // is furthest along. False if the tile is the goal or has no way there.
+    bool NextStep(int tileX, int tileY, int& stepX, int& stepY) const;
+    
+private:
+    static const int WIDTH = RoomTheme::GRID_WIDTH;
+    static const int HEIGHT = RoomTheme::GRID_HEIGHT;
+    
+    int roomId;  // Room and goal the field was built for; -1 before the first build
+    int goalX, goalY;
+    uint16_t distance[HEIGHT][WIDTH];
+};
\ No newline at end of file
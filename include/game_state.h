@@ -0,0 +1,82 @@
+#pragma once
+#include "room.h"
+#include "monster_store.h"
+#include "rng.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// Everything a running game knows about the world and the player, with no notion of
+// windows, input devices or wall-clock time. Simulation owns and mutates it; renderers
+// only ever get a const reference.
+struct GameState {
+    Room* currentRoom;
+    std::vector<std::unique_ptr<Room>> rooms;
+    MonsterStore monsters;  // Every room's monsters, grouped by room id
+    std::vector<Item> inventory;
+    int playerHealth;
+    int basePlayerAttack;
+    int basePlayerArmor;
+
+    // Equipment slots - use indices instead of pointers to avoid vector reallocation issues
+    int equippedWeaponIndex;  // -1 if no weapon equipped
+    int equippedArmorIndex;   // -1 if no armor equipped
+
+    // Player position within current room
+    float playerRoomX, playerRoomY;
+    float prevPlayerRoomX, prevPlayerRoomY;  // Before the last tick, for render interpolation
+    float playerSpeed;
+    bool isFemale;
+    int moveTicks;  // Ticks since the player last stepped
+
+    // Animation state
+    int walkAnimFrame;
+    int animTicks;
+    bool isWalking;
+
+    // Special discoveries
+    bool bookTaken;
+    bool scrollTaken;
+    bool mapUnlocked;
+    bool infirmaryRevealed;
+    bool inMapView;
+    bool hasKey;
+    bool gemUsed;
+    bool hasTeleport;
+    bool strangeMet;
+
+    // Staff quest variables
+    bool noteRead;
+    bool hasStaff;
+    bool hasDiamond;
+    bool hasEmerald;
+    bool hasOpal;
+    bool staffComplete;
+    bool gameEnding;
+    bool shouldQuit;
+    bool waitingForContinue;
+    int endingPhase; // 0=normal, 1=white, 2=yellow, 3=red, 4=black, 5=gameover
+    int endingTicks;
+
+    // Simulation clock in fixed ticks, advanced only by Simulation::Tick
+    uint64_t tick;
+    uint64_t lastMonsterAttackTick;
+    
+    // All randomness in the game comes from here, never from rand()
+    Rng rng;
+    
+    GameState();
+
+    int GetTotalAttack() const;
+    int GetTotalArmor() const;
+    
+    // Room registry. A room's id is its position in rooms, which RoomFactory keeps fixed,
+    // so ids also mean the same room across saves. Call IndexRooms after replacing rooms.
+    void IndexRooms();
+    Room* FindRoom(Name name) const;
+    
+private:
+    std::unordered_map<uint32_t, Room*> roomsByName;
+};
\ No newline at end of file
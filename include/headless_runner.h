@@ -0,0 +1,26 @@
+#pragma once
+#include "simulation.h"
+#include "tokenizer.h"
+#include <istream>
+
+// Drives a Simulation from a script instead of a keyboard, at a fixed timestep.
+// Lines are typed commands, except for directives that stand in for the keyboard and clock:
+//   :wait <seconds>                       let time pass, an hour at most
+//   :hold <up|down|left|right> <seconds>  hold an arrow key
+//   :attack                               press the attack key
+//   :closemap                             press shift
+//   :expect <text>                        fail unless a message since the last line contains text
+//   # ...                                 comment
+class HeadlessRunner {
+public:
+    explicit HeadlessRunner(Simulation& simulation);
+
+    // Returns a process exit code: 0 when every :expect held
+    int Run(std::istream& script);
+
+private:
+    void RunTicks(float seconds, const TickInput& input);
+
+    Simulation& simulation;
+    Tokenizer tokenizer;
+};
\ No newline at end of file
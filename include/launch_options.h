@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Command-line options of retro_dungeon and retro_dungeon_headless, read in one place so
+// both front ends parse numbers and report mistakes the same way.
+struct LaunchOptions {
+    // Which options a front end accepts; any other argument is a mistake
+    static const unsigned QUIET = 1 << 0;
+    static const unsigned SEED = 1 << 1;
+    static const unsigned RECORD = 1 << 2;
+    static const unsigned REPLAY = 1 << 3;
+    static const unsigned LOAD = 1 << 4;
+    static const unsigned SAVE = 1 << 5;
+    static const unsigned DEPTHS = 1 << 6;
+    static const unsigned SCRIPT = 1 << 7;  // One bare argument, the script path
+    
+    bool quiet = false;
+    uint64_t seed = 1;
+    int depthRooms = 0;
+    std::string scriptPath;
+    std::string recordPath;
+    std::string replayPath;
+    std::string loadPath;
+    std::string savePath;
+    
+    // Stops at the first unknown option, option missing its value, or number that doesn't
+    // parse or is out of range; reports it with usage on std::cerr and returns false
+    bool Parse(int argc, char** argv, unsigned accepted, const char* usage);
+    
+    // The whole of text as a decimal number; no sign, no trailing characters
+    static bool ParseNumber(const char* text, uint64_t& value);
+};
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstddef>
+
+// Adventure log with a fixed in-memory window. Once the window is full the oldest
+// message is appended to a spill file, so memory stays flat however long a session runs.
+// Messages are numbered from 0 for the whole session; [GetFirstInMemory(), GetTotalCount())
+// live in memory and anything older has to be read back with LoadSpilled.
+class MessageLog {
+public:
+    // An empty spillPath keeps the window but simply forgets evicted messages.
+    // The spill file belongs to the log and is deleted with it.
+    MessageLog(size_t capacity, const std::string& spillPath);
+    ~MessageLog();
+    
+    void Add(const std::string& message);
+
+    size_t GetTotalCount() const { return spilledCount + count; }
+    size_t GetFirstInMemory() const { return spilledCount; }
+    size_t GetCapacity() const { return ring.size(); }
+
+    // Valid for GetFirstInMemory() <= index < GetTotalCount()
+    const std::string& Get(size_t index) const;
+
+    // Reads up to maxCount spilled messages ending just before endIndex, oldest first.
+    // Paging backwards from the previous call's start only touches the records it returns.
+    std::vector<std::string> LoadSpilled(size_t endIndex, size_t maxCount) const;
+
+private:
+    // False if the message didn't make it into the file
+    bool Spill(const std::string& message);
+    bool ReadRecordBefore(std::streamoff& offset, std::string* message) const;
+
+    std::vector<std::string> ring;
+    size_t head;  // Slot holding the oldest in-memory message
+    size_t count;
+    size_t spilledCount;
+
+    // Records are [u32 length][bytes][u32 length] so the file can be walked from either end.
+    // Reading back moves the stream and the cursor but doesn't change the log itself
+    mutable std::fstream spillFile;
+    std::string spillPath;
+    std::streamoff spillEnd;
+
+    // Where the last LoadSpilled stopped, so scrolling further back resumes there
+    mutable size_t cursorIndex;
+    mutable std::streamoff cursorOffset;
+};
\ No newline at end of file
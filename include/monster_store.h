@@ -0,0 +1,105 @@
+#pragma once
+#include "room.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Every monster in the dungeon, stored column by column. The per-tick AI only walks the
+// hot columns, each its own contiguous array, while names, descriptions and combat stats
+// sit elsewhere and never share cache lines with positions.
+// Monsters are grouped by room: room r owns indices [RoomBegin(r), RoomEnd(r)).
+// Positions are also bucketed into a coarse grid per room, so proximity queries only
+// look at monsters in nearby cells; move monsters with SetPosition to keep it current.
+struct MonsterStore {
+    // Hot: read or written by every monster on every tick
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;  // Before the last tick, for render interpolation
+    std::vector<float> aggroRange;
+    std::vector<int32_t> moveTicks;   // Ticks since the monster last stepped
+    std::vector<uint8_t> alive;
+    std::vector<uint8_t> isAggro;
+    
+    // Warm: only touched when a monster steps or fights
+    std::vector<float> targetX, targetY;
+    std::vector<int32_t> health;
+    std::vector<int32_t> attack;
+    
+    // Cold: only needed for text
+    std::vector<Name> name;
+    std::vector<std::string> description;
+    
+    // Replaces the whole store with each room's spawn list, in room id order.
+    // Rooms must already be indexed (see GameState::IndexRooms).
+    void Build(std::vector<std::unique_ptr<Room>>& rooms);
+    
+    size_t Size() const { return x.size(); }
+    size_t RoomBegin(int roomId) const { return roomFirst[roomId]; }
+    size_t RoomEnd(int roomId) const { return roomFirst[roomId + 1]; }
+    
+    // Moves a monster and updates its grid cell. x and y may be written directly only
+    // by code that puts them back before the next query.
+    void SetPosition(size_t index, float newX, float newY);
+    
+    // Closest living monster in the room strictly within radius of (px, py), by squared
+    // distance, lowest index on a tie; Size() if there is none
+    size_t FindNearest(int roomId, float px, float py, float radius) const;
+    
+    // Calls visit(index) for every living monster in the room within radius (inclusive)
+    // of (px, py). Order follows the grid, not the index.
+    template <typename Visit>
+    void ForEachWithin(int roomId, float px, float py, float radius, Visit&& visit) const;
+    
+    // Distance and step timer pass over monsters [first, last): counts each live monster's
+    // moveTicks up, latches isAggro once the player is in range, and writes each squared
+    // distance to the player into distSquared[index - first]. Never touches the RNG.
+    void UpdateAggro(size_t first, size_t last, float playerX, float playerY, float* distSquared);
+    
+    // Reassembles one monster, for saving
+    Monster Get(size_t index) const;
+    
+private:
+    void Add(const Monster& monster);
+    void AddToCell(size_t index, uint32_t cell);
+    void RemoveFromCell(size_t index, uint32_t cell);
+    uint32_t CellOf(int roomId, float px, float py) const;
+    static void AggroKernel(size_t count, const float* __restrict x, const float* __restrict y, const float* __restrict aggroRange, const uint8_t* __restrict alive, int32_t* __restrict moveTicks, uint8_t* __restrict isAggro, float* __restrict distSquared, float playerX, float playerY);
+    
+    std::vector<size_t> roomFirst;  // One entry per room plus an end marker
+    
+    // Spatial grid: each room is GRID_COLUMNS x GRID_ROWS cells of GRID_CELL_TILES tiles
+    // square. The monsters standing in cell room * GRID_CELLS + c form a list starting at
+    // cellHead[that cell] and linked through nextInCell, so an empty room costs one word
+    // per cell. cellOf records which cell each monster is in.
+    static const int GRID_CELL_TILES = 2;
+    static const int GRID_COLUMNS = (RoomTheme::GRID_WIDTH + GRID_CELL_TILES - 1) / GRID_CELL_TILES;
+    static const int GRID_ROWS = (RoomTheme::GRID_HEIGHT + GRID_CELL_TILES - 1) / GRID_CELL_TILES;
+    static const int GRID_CELLS = GRID_COLUMNS * GRID_ROWS;
+    static constexpr uint32_t NO_MONSTER = 0xFFFFFFFF;
+    std::vector<uint32_t> cellHead;
+    std::vector<uint32_t> nextInCell;
+    std::vector<uint32_t> cellOf;
+};
+
+template <typename Visit>
+void MonsterStore::ForEachWithin(int roomId, float px, float py, float radius, Visit&& visit) const {
+    float radiusSquared = radius * radius;
+    int firstColumn = std::max(0, (int)std::floor((px - radius) / GRID_CELL_TILES));
+    int lastColumn = std::min(GRID_COLUMNS - 1, (int)std::floor((px + radius) / GRID_CELL_TILES));
+    int firstRow = std::max(0, (int)std::floor((py - radius) / GRID_CELL_TILES));
+    int lastRow = std::min(GRID_ROWS - 1, (int)std::floor((py + radius) / GRID_CELL_TILES));
+    
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            for (uint32_t i = cellHead[(size_t)roomId * GRID_CELLS + row * GRID_COLUMNS + column]; i != NO_MONSTER; i = nextInCell[i]) {
+                float dx = px - x[i];
+                float dy = py - y[i];
+                if (alive[i] && dx * dx + dy * dy <= radiusSquared) {
+                    visit((size_t)i);
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
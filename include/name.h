@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Interned identifier for item, monster and room names. Each distinct spelling is given
+// a small integer the first time it is seen, so entities carry four bytes instead of a
+// string and compare names with a single integer compare. The text is only looked up
+// when something is shown to the player.
+class Name {
+public:
+    Name() : id(0) {} // The empty name
+    explicit Name(std::string_view text) : id(Intern(text)) {}
+    
+    // The name spelled text if anything has been given that name, or one that matches
+    // nothing otherwise. Meant for player input, so typos don't grow the table.
+    static Name Find(std::string_view text);
+    
+    const std::string& GetText() const;
+    uint32_t GetId() const { return id; }
+    
+    bool operator==(Name other) const { return id == other.id; }
+    bool operator!=(Name other) const { return id != other.id; }
+    
+private:
+    static const uint32_t NONE = 0xFFFFFFFFu;
+    static uint32_t Intern(std::string_view text);
+    
+    uint32_t id;
+};
\ No newline at end of file
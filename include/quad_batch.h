@@ -0,0 +1,43 @@
+#pragma once
+#include "raylib.h"
+#include <vector>
+
+// Collects solid rectangles, outlines and thick lines as untextured quads in one vertex
+// array, then hands the whole array to rlgl in as few submissions as its render batch
+// allows. One Flush is one layer: everything added since the last Flush lands in the
+// order it was added, on top of whatever was drawn before the Flush and below anything
+// drawn after it, so text that has to sit on top is drawn between flushes.
+class QuadBatch {
+public:
+    // Counted from the last ResetStats
+    struct Stats {
+        int primitives = 0;  // Rect, Outline and Line calls, i.e. the DrawRectangle* calls saved
+        int submissions = 0; // rlBegin/rlEnd blocks handed to rlgl, which merges them into its own batch
+        int vertices = 0;
+    };
+    
+    // Same pixels as DrawRectangle, DrawRectangleLines and DrawLineEx
+    void Rect(int x, int y, int width, int height, Color color);
+    void Outline(int x, int y, int width, int height, Color color);
+    void Line(Vector2 from, Vector2 to, float thickness, Color color);
+    
+    // Submits everything added so far and starts an empty layer
+    void Flush();
+    
+    const Stats& GetStats() const { return stats; }
+    void ResetStats() { stats = Stats(); }
+
+private:
+    // Kept well under rlgl's default batch, so a submission never splits mid-layer
+    static const int MAX_SUBMIT_VERTICES = 4096;
+    
+    struct Vertex {
+        float x, y;
+        Color color;
+    };
+    std::vector<Vertex> vertices;  // Four per quad, counter-clockwise from the top left
+    Stats stats;
+    
+    void AddRect(int x, int y, int width, int height, Color color);
+    void AddQuad(Vector2 a, Vector2 b, Vector2 c, Vector2 d, Color color);
+};
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "simulation.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// Replay files hold everything that was fed into a Simulation, so a session can be rerun
+// exactly: the RNG seed, then a stream of events stamped with the tick they happened before.
+//   header: "RDRP", u8 version, u64 seed (little-endian), varint generated room count
+//   event:  u8 type, varint ticks since the previous event, payload
+// Controls are stored only on ticks where they change, so an idle stretch costs nothing.
+enum class ReplayEvent : uint8_t {
+    INPUT = 1,     // u8 bitmask of TickInput
+    COMMAND = 2,   // varint length, bytes
+    TELEPORT = 3,  // varint length, bytes
+    END = 4        // Tick the session stopped at
+};
+
+class ReplayWriter {
+public:
+    ReplayWriter();
+    
+    // Must be opened before the simulation's first tick
+    bool Open(const std::string& path, uint64_t seed, int depthRooms);
+    void Close(uint64_t finalTick);
+    bool IsOpen() const { return file.is_open(); }
+    
+    void RecordInput(uint64_t tick, const TickInput& input);
+    void RecordCommand(uint64_t tick, const std::string& command);
+    void RecordTeleport(uint64_t tick, const std::string& roomName);
+    
+private:
+    void WriteEvent(ReplayEvent type, uint64_t tick);
+    void WriteVarint(uint64_t value);
+    void WriteString(const std::string& text);
+    
+    std::ofstream file;
+    uint64_t lastTick;
+    uint8_t lastInputMask;
+};
+
+class ReplayPlayer {
+public:
+    ReplayPlayer();
+    
+    bool Open(const std::string& path);
+    uint64_t GetSeed() const { return seed; }
+    int GetDepthRooms() const { return depthRooms; }
+    
+    // Feeds the whole recording into a simulation built with GetSeed() and GetDepthRooms(), as fast as it will go.
+    // A file cut short (a crashed session, say) plays up to where it stops. Returns false,
+    // having played up to the damage, if the file holds something no writer produces.
+    bool Play(Simulation& simulation);
+    
+private:
+    bool PlayEvents(Simulation& simulation);
+    bool ReadVarint(uint64_t& value);
+    bool ReadString(std::string& text);
+    
+    std::ifstream file;
+    uint64_t seed;
+    int depthRooms;
+    uint64_t fileSize;  // Bounds string lengths read from the file
+};
\ No newline at end of file
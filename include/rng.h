@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+// Small seedable generator (xoshiro128**). Every simulation owns its own, so two runs
+// with the same seed play out identically and parallel sessions never share state.
+class Rng {
+public:
+    explicit Rng(uint64_t seed = 1);
+    
+    void Seed(uint64_t seed);
+    uint64_t GetSeed() const { return seed; }
+    
+    // Raw generator state, so a saved game can resume the exact same stream
+    void GetState(uint32_t out[4]) const;
+    void SetState(uint64_t seed, const uint32_t in[4]);
+    
+    uint32_t Next() {
+        uint32_t result = Rotl(s[1] * 5, 7) * 9;
+        uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rotl(s[3], 11);
+        return result;
+    }
+    
+    // Uniform in [0, bound); bound must be positive
+    int NextInt(int bound) {
+        return (int)(((uint64_t)Next() * (uint32_t)bound) >> 32);
+    }
+    
+    // Stateless draw in [0, bound) keyed on this seed and a, b. For work that must not
+    // disturb the main stream, or depend on the order it happens to run in.
+    int HashInt(uint64_t a, uint64_t b, int bound) const;
+    
+private:
+    static uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+    
+    uint64_t seed;
+    uint32_t s[4];
+};
\ No newline at end of file
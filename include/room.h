@@ -1,8 +1,11 @@
 #pragma once
+#include "room_theme.h"
+#include "name.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <cstdint>
 
 enum class ItemType {
     MISC,
@@ -11,7 +14,7 @@ enum class ItemType {
 };
 
 struct Item {
-    std::string name;
+    Name name;
     std::string description;
     bool takeable;
     ItemType type;
@@ -25,23 +28,26 @@ struct Item {
 };
 
 struct Monster {
-    std::string name;
+    Name name;
     std::string description;
     int health;
     int attack;
     bool alive;
     float x, y;
     float targetX, targetY;
-    float moveTimer;
+    float prevX, prevY;  // Position before the last tick, for render interpolation
+    int moveTicks;       // Ticks since the monster last stepped
     float aggroRange;
     bool isAggro;
     
     Monster(const std::string& n, const std::string& desc, int hp, int atk, float startX = 10.0f, float startY = 10.0f)
         : name(n), description(desc), health(hp), attack(atk), alive(true), 
-          x(startX), y(startY), targetX(startX), targetY(startY), moveTimer(0.0f), 
+          x(startX), y(startY), targetX(startX), targetY(startY), prevX(startX), prevY(startY), moveTicks(0), 
           aggroRange(4.0f), isAggro(false) {}
 };
 
+struct MonsterStore;
+
 class Room {
 public:
     Room(const std::string& name, const std::string& description);
@@ -50,25 +56,53 @@ public:
     Room* GetExit(const std::string& direction);
     
     void AddItem(const Item& item);
+    
+    // Monsters are only parked here until the world is assembled; after that they live
+    // in GameState::monsters (see MonsterStore::Build, which takes them out again)
     void AddMonster(const Monster& monster);
+    std::vector<Monster> TakeSpawns();
+    
+    bool RemoveItem(Name itemName);
     
-    bool RemoveItem(const std::string& itemName);
+    // Drops all exits, items and spawns, for restoring a saved game into a fresh room
+    void ClearContents();
     
-    std::string GetName() const { return name; }
-    std::string GetDescription() const;
+    Name GetName() const { return name; }
+    int GetId() const { return id; } // Index in GameState::rooms, -1 until indexed
+    void SetId(int newId) { id = newId; }
+    std::string GetDescription(const MonsterStore& monsters) const;
     std::vector<std::string> GetExits() const;
+    std::vector<Room*> GetAdjacentRooms() const; // Exit destinations, each listed once
     std::vector<Item> GetItems() const { return items; }
-    std::vector<Monster>& GetMonsters() { return monsters; }
-    const std::vector<Monster>& GetMonsters() const { return monsters; }
     
     bool IsVisited() const { return visited; }
     void SetVisited(bool v) { visited = v; }
     
+    // Bumped whenever exits or items change, so cached renders know to rebuild
+    unsigned int GetRevision() const { return revision; }
+    
+    // Floor and props, filled in by RoomFactory
+    RoomTheme& GetTheme() { return theme; }
+    const RoomTheme& GetTheme() const { return theme; }
+    
+    // Packs the border walls and the theme's obstacles into the walkability mask
+    void BuildWalkMask();
+    bool IsWalkable(int tileX, int tileY) const {
+        if ((unsigned)tileX >= (unsigned)RoomTheme::GRID_WIDTH || (unsigned)tileY >= (unsigned)RoomTheme::GRID_HEIGHT) {
+            return false;
+        }
+        return (walkableRows[tileY] >> tileX) & 1u;
+    }
+    
 private:
-    std::string name;
+    Name name;
+    int id;
     std::string description;
     std::map<std::string, Room*> exits;
     std::vector<Item> items;
-    std::vector<Monster> monsters;
+    std::vector<Monster> spawns;
     bool visited;
+    unsigned int revision;
+    RoomTheme theme;
+    uint32_t walkableRows[RoomTheme::GRID_HEIGHT]; // Bit x of row y set if tile (x, y) is walkable
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "room.h"
+#include "rng.h"
+#include <vector>
+#include <memory>
+
+class RoomFactory {
+public:
+    // The hand-built story rooms, at fixed indices [0, STORY_ROOM_COUNT)
+    static const int STORY_ROOM_COUNT = 15;
+    
+    // The story rooms, followed by depthRooms generated ones from rng's seed (see DungeonGenerator)
+    static std::vector<std::unique_ptr<Room>> CreateAllRooms(Rng& rng, int depthRooms = 0);
+    static void ConnectRooms(std::vector<std::unique_ptr<Room>>& rooms);
+    
+private:
+    static std::unique_ptr<Room> CreateEntranceHall();
+    static std::unique_ptr<Room> CreateArmory();
+    static std::unique_ptr<Room> CreateTreasureChamber();
+    static std::unique_ptr<Room> CreateDarkCorridor();
+    static std::unique_ptr<Room> CreateMonsterLair();
+    static std::unique_ptr<Room> CreateLibrary(Rng& rng);
+    static std::unique_ptr<Room> CreateKitchen();
+    static std::unique_ptr<Room> CreateBasement();
+    static std::unique_ptr<Room> CreateThroneRoom();
+    static std::unique_ptr<Room> CreateGarden(Rng& rng);
+    static std::unique_ptr<Room> CreateInfirmary();
+    static std::unique_ptr<Room> CreateSunlitMeadow();
+    static std::unique_ptr<Room> CreateDarkRoom();
+    static std::unique_ptr<Room> CreateChapel();
+    static std::unique_ptr<Room> CreateSleepingQuarters();
+};
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+
+// Plain RGBA so rooms can describe their look without depending on raylib
+struct PixelColor {
+    unsigned char r, g, b, a;
+};
+
+enum class PropShape {
+    FILLED,
+    OUTLINE
+};
+
+// A single pixel-art primitive, positioned in pixels from the room's top-left tile
+struct RoomProp {
+    PropShape shape;
+    int x, y;
+    int width, height;
+    PixelColor color;
+};
+
+// Tile footprint of a prop that nothing can walk through
+struct RoomObstacle {
+    int tileX, tileY;
+    int tilesWide, tilesHigh;
+};
+
+// Everything needed to draw a room's static scenery, plus which of its props are solid
+class RoomTheme {
+public:
+    RoomTheme();
+
+    void SetFloorColor(PixelColor color) { floorColor = color; }
+    PixelColor GetFloorColor() const { return floorColor; }
+
+    void AddRect(int x, int y, int width, int height, PixelColor color);
+    void AddOutline(int x, int y, int width, int height, PixelColor color);
+    const std::vector<RoomProp>& GetProps() const { return props; }
+
+    // A solid prop filling whole tiles; drawn like AddRect and blocks movement over its footprint
+    void AddObstacle(int tileX, int tileY, int tilesWide, int tilesHigh, PixelColor color);
+    const std::vector<RoomObstacle>& GetObstacles() const { return obstacles; }
+
+    static const int GRID_WIDTH = 24;
+    static const int GRID_HEIGHT = 18;
+    static const int TILE_SIZE = 32;
+
+private:
+    PixelColor floorColor;
+    std::vector<RoomProp> props;
+    std::vector<RoomObstacle> obstacles;
+};
\ No newline at end of file
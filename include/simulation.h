@@ -0,0 +1,161 @@
+#pragma once
+#include "game_state.h"
+#include "message_log.h"
+#include "tokenizer.h"
+#include "flow_field.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+
+class ReplayWriter;
+
+// Player controls sampled for a single simulation step
+struct TickInput {
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+    bool attack = false;   // Pressed this step
+    bool closeMap = false; // Pressed this step
+};
+
+// The game rules: command interpreter, movement, monster AI and combat. Advances only
+// when told to, by whatever drives it (the raylib front end, a script, a test harness),
+// and always by exactly one fixed tick so the outcome never depends on frame rate.
+class Simulation {
+public:
+    static const int TICK_RATE = 60;
+    static constexpr float TICK_SECONDS = 1.0f / TICK_RATE;
+    static const int MAX_DEPTH_ROOMS = 1000000;
+    static const int MAX_WAIT_TICKS = 60 * 60 * TICK_RATE;  // Longest stretch a script wait or replay gap covers
+    static const int NO_PENDING_EVENT = -1;
+    
+    // An empty logSpillPath keeps older messages out of the filesystem entirely.
+    // depthRooms generated rooms are added below the basement (see DungeonGenerator).
+    // The same seed, room count and inputs always produce the same game.
+    Simulation(const std::string& logSpillPath, uint64_t seed, int depthRooms = 0);
+    
+    // A line typed by the player; echoed to the log before it runs
+    void SubmitCommand(const std::string& command);
+    void Tick(const TickInput& input);
+    void TeleportToRoom(const std::string& roomName);
+    
+    // Binary snapshots of the whole game (see Snapshot); a failed load changes nothing
+    bool SaveSnapshot(const std::string& path) const;
+    bool LoadSnapshot(const std::string& path);
+    
+    const GameState& GetState() const { return state; }
+    const MessageLog& GetLog() const { return messageLog; }
+    
+    // Changes whenever the rooms are rebuilt (by loading a snapshot), so anything
+    // caching per-Room data knows the old pointers are gone
+    unsigned int GetWorldGeneration() const { return worldGeneration; }
+    
+    // Changes whenever something a renderer shows may have: a message, a command, the
+    // player or a current-room monster moving, a walk pose or an ending phase. A renderer
+    // that drew at one revision has nothing new to draw until it moves on.
+    unsigned int GetViewRevision() const { return viewRevision; }
+    
+    // Ticks until the next tick that could change the view with no input at all: a
+    // current-room monster stepping or attacking, the next walk pose or player step,
+    // the next ending phase. NO_PENDING_EVENT if nothing will happen until the player
+    // does something; neighbouring rooms' monsters are out of sight and don't count.
+    int TicksUntilNextEvent() const;
+    
+    // Every new message is also written here, if set
+    void SetEcho(std::ostream* out) { echo = out; }
+    
+    // Commands, teleports and controls are reported here as they are applied, if set
+    void SetRecorder(ReplayWriter* writer) { recorder = writer; }
+    
+    // Set while a ReplayPlayer drives the simulation
+    void SetReplaying(bool isReplaying) { replaying = isReplaying; }
+    
+private:
+    void ExecuteCommand(const std::string& command);
+    
+    // Command dispatch: verbs are looked up in a hash index over COMMANDS
+    struct CommandSpec {
+        const char* verb;
+        bool needsArgument;
+        void (Simulation::*handler)(std::string_view argument);
+    };
+    static const CommandSpec COMMANDS[];
+    static const CommandSpec* FindCommand(std::string_view verb);
+    
+    void HandleHelp(std::string_view);
+    void HandleMale(std::string_view);
+    void HandleFemale(std::string_view);
+    void HandleLook(std::string_view);
+    void HandleGo(std::string_view argument);
+    void HandleTake(std::string_view argument);
+    void HandleInventory(std::string_view);
+    void HandleEquip(std::string_view argument);
+    void HandleDrop(std::string_view argument);
+    void HandleStats(std::string_view argument);
+    void HandleUse(std::string_view argument);
+    void HandleMap(std::string_view);
+    void HandleCombine(std::string_view);
+    void HandleContinue(std::string_view);
+    void HandleSave(std::string_view);
+    void HandleLoad(std::string_view);
+    void HandleQuit(std::string_view);
+    bool IsSaveFileLocked();
+    
+    void InitializeDungeon(int depthRooms);
+    void AddMessage(const std::string& message);
+    void MovePlayer(float deltaX, float deltaY);
+    void SnapInterpolation();
+    void UpdateMonsters();
+    void UpdateBackgroundMonsters();
+    void WanderMonster(size_t index, const Room& room, int direction);
+    void CheckMonsterCollisions();
+    void AttackNearestMonster();
+    Item* FindItemInInventory(const std::string& itemName);
+    int FindItemIndexInInventory(const std::string& itemName);
+    void EquipItem(const std::string& itemName);
+    void DropItem(const std::string& itemName);
+    void ShowItemStats(const std::string& itemName);
+    void UseItem(const std::string& itemName);
+
+    GameState state;
+    MessageLog messageLog;
+    std::ostream* echo;
+    ReplayWriter* recorder;
+    bool replaying;
+    unsigned int worldGeneration;
+    unsigned int viewRevision;
+    
+    Tokenizer commandTokenizer;  // Reused by every command
+    std::vector<float> monsterDistances;  // UpdateMonsters scratch, squared distance to the player
+    FlowField chaseField;                 // Paths to the player in the current room, for aggroed monsters
+    
+    // Level-of-detail monster AI. The current room runs every tick; rooms one exit away
+    // run coarsely, each of their monsters once per BACKGROUND_TICKS, spread evenly over
+    // that window; every other room is dormant. Per-tick cost is bounded by the current
+    // room's neighbours, however many rooms the dungeon has.
+    struct BackgroundMonster {
+        size_t index;      // In GameState::monsters
+        const Room* room;  // Whose walk mask it moves on
+    };
+    std::vector<BackgroundMonster> backgroundMonsters;
+    int backgroundRoomId;                   // Room the list was built around, or -1
+    unsigned int backgroundRoomRevision;    // Its revision then, which moves with its exits
+    unsigned int backgroundWorldGeneration;
+    
+    // Room view bounds, shared with the renderer's grid
+    static const int ROOM_GRID_WIDTH = RoomTheme::GRID_WIDTH;
+    static const int ROOM_GRID_HEIGHT = RoomTheme::GRID_HEIGHT;
+    static constexpr float ATTACK_RANGE = 3.0f;  // In tiles, exclusive
+    static const int MAX_MESSAGES = 256;  // Kept in memory; older messages spill to disk
+    static constexpr const char* SAVE_PATH = "savegame.rds";
+    
+    // Durations in ticks
+    static const int PLAYER_MOVE_TICKS = 5;       // Between steps while an arrow key is held
+    static const int MONSTER_MOVE_TICKS = 18;     // 0.3 s, slower than the player
+    static const int WALK_FRAME_TICKS = 24;       // Each walk pose is held 0.4 s
+    static const int ENDING_PHASE_TICKS = 90;     // 1.5 s per ending colour
+    static const int MONSTER_ATTACK_TICKS = 120;  // 2 s between monster hits
+    static const int BACKGROUND_TICKS = 60;       // 1 s between steps in neighbouring rooms
+};
\ No newline at end of file
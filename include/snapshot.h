@@ -0,0 +1,23 @@
+#pragma once
+#include "game_state.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Versioned binary save format for a whole GameState. Everything is fixed-width and
+// little-endian, written in one flat run after a small header, so a saved file can be
+// mapped into memory and decoded in place without an intermediate parse tree.
+//   header:  "RDSV", u32 version, u64 seed, u32 payload size, u32 FNV-1a of the payload
+//   payload: clock and RNG, player, flags, inventory, then every room's dynamic contents
+// Static room data (themes, collision) isn't stored; it is rebuilt from the seed.
+class Snapshot {
+public:
+    static const uint32_t VERSION = 1;
+    
+    static std::vector<uint8_t> Serialize(const GameState& state);
+    // Leaves state untouched unless the whole snapshot decodes cleanly
+    static bool Deserialize(GameState& state, const uint8_t* data, size_t size);
+    
+    static bool Save(const GameState& state, const std::string& path);
+    static bool Load(GameState& state, const std::string& path);
+};
\ No newline at end of file
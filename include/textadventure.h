@@ -1,15 +1,22 @@
 #pragma once
 #include "raylib.h"
-#include "room.h"
-#include "room_factory.h"
+#include "simulation.h"
+#include "replay.h"
+#include "quad_batch.h"
+#include "tokenizer.h"
 #include <string>
 #include <vector>
-#include <memory>
-#include <sstream>
+#include <map>
+#include <unordered_map>
+#include <deque>
 
+// raylib front end: turns keyboard and mouse into Simulation input and draws whatever
+// state the simulation is in. It never changes game state directly.
 class TextAdventure {
 public:
-    TextAdventure();
+    // A non-empty recordPath writes a replay of the whole session there; depthRooms
+    // generated rooms are added below the basement
+    explicit TextAdventure(const std::string& recordPath = "", int depthRooms = 0);
     ~TextAdventure();
     
     void Run();
@@ -18,99 +25,228 @@ private:
     void Update();
     void Draw();
     void ProcessInput();
-    void ExecuteCommand(const std::string& command);
+    bool IsAnimating() const;
+    void WaitForChange();
     
-    void InitializeDungeon();
     void DrawMap();
+    void ClearRoomLayoutCache();
     void DrawTextPanel();
-    void AddMessage(const std::string& message);
+    void UpdateWrappedLog(int maxWidth, int fontSize, bool keepHistory);
+    int PageInLogHistory(int maxWidth, int fontSize);
     
-    std::vector<std::string> SplitString(const std::string& str, char delimiter);
-    std::string ToLower(const std::string& str);
     std::vector<std::string> WrapText(const std::string& text, int maxWidth, int fontSize);
+    Tokenizer paragraphTokenizer;  // WrapText scratch, kept so wrapping doesn't allocate per word
+    Tokenizer wordTokenizer;
     
-    // Game state
-    Room* currentRoom;
-    std::vector<std::unique_ptr<Room>> rooms;
-    std::vector<Item> inventory;
-    std::vector<std::string> messages;
+    // Game state lives in the simulation; the renderer only reads it
+    Simulation simulation;
+    const GameState& state;
+    ReplayWriter recorder;
     std::string currentInput;
-    int playerHealth;
-    int basePlayerAttack;
-    int basePlayerArmor;
-    
-    // Equipment slots - use indices instead of pointers to avoid vector reallocation issues
-    int equippedWeaponIndex;  // -1 if no weapon equipped
-    int equippedArmorIndex;   // -1 if no armor equipped
     
     // Display constants
     static const int SCREEN_WIDTH = 1800;
     static const int SCREEN_HEIGHT = 1200;
     static const int MAP_WIDTH = 900;
     static const int TEXT_WIDTH = 880;
-    static const int MAX_MESSAGES = 35;
+    static const int LOG_PAGE_SIZE = 64;  // Messages paged back in per scroll past the top
+    static const int STATS_PANEL_HEIGHT = 140;
+    
+    // Fixed-timestep loop: frame time is banked and spent in whole simulation ticks
+    static constexpr float MAX_FRAME_TIME = 0.25f;    // A longer hitch is not caught up on
+    static constexpr float FAST_FORWARD_SPEED = 4.0f; // While TAB is held
+    static constexpr float IDLE_POLL_SECONDS = 0.05f; // Longest an idle wait for a timer goes without checking input
     
     // Room view constants
-    static const int ROOM_GRID_WIDTH = 24;
-    static const int ROOM_GRID_HEIGHT = 18;
-    static const int TILE_SIZE = 32;
+    static const int ROOM_GRID_WIDTH = RoomTheme::GRID_WIDTH;
+    static const int ROOM_GRID_HEIGHT = RoomTheme::GRID_HEIGHT;
+    static const int TILE_SIZE = RoomTheme::TILE_SIZE;
     
-    // Player position within current room
-    float playerRoomX, playerRoomY;
-    float playerSpeed;
-    bool isFemale;
-    float moveTimer;
+    // Dungeon map grid, at full size; a bigger dungeon is shrunk to fit, then scrolled
+    static const int MAP_CELL_WIDTH = 140;
+    static const int MAP_CELL_HEIGHT = 80;
+    static const int MAP_CELL_GAP = 15;  // Space between neighbouring room boxes
+    static const int MAP_VIEW_X = 50;    // Area the rooms are drawn in, between the title and the legend
+    static const int MAP_VIEW_Y = 140;
+    static const int MAP_VIEW_WIDTH = 860;
+    static const int MAP_VIEW_HEIGHT = 890;
+    static constexpr float MIN_MAP_SCALE = 0.15f;
+    static const int MIN_MAP_FONT_SIZE = 10;  // Room names are left off boxes too small for this
     
-    // Animation state
-    int walkAnimFrame;
-    float animTimer;
-    bool isWalking;
+    // Input collected since the last tick; presses wait here until a tick consumes them
+    TickInput pendingInput;
+    float tickAccumulator;
+    float tickAlpha;  // How far between the previous and current tick this frame is drawn
+    double lastLoopTime;
+    
+    // Frames are only drawn when they would differ from the last one drawn
+    unsigned int drawnViewRevision;  // Simulation view revision of the last frame
+    bool viewDirty;                  // Input changed something the front end itself shows
+    bool wasAnimating;               // The last frame was drawn mid-interpolation
     
     // Chat scrolling
     int chatScrollOffset;
     
-    // Special discoveries
-    bool bookTaken;
-    bool scrollTaken;
-    bool mapUnlocked;
-    bool infirmaryRevealed;
-    bool inMapView;
-    bool hasKey;
-    bool gemUsed;
-    bool hasTeleport;
-    bool strangeMet;
-    
-    // Staff quest variables
-    bool noteRead;
-    bool hasStaff;
-    bool hasDiamond;
-    bool hasEmerald;
-    bool hasOpal;
-    bool staffComplete;
-    bool gameEnding;
-    bool shouldQuit;
-    bool waitingForContinue;
-    int endingPhase; // 0=normal, 1=white, 2=yellow, 3=red, 4=black, 5=gameover
-    float endingTimer;
+    // Baked static scenery (floor, walls, props) per room
+    struct RoomLayoutCache {
+        RenderTexture2D texture = {};
+        unsigned int revision = 0; // Room revision the texture was baked at
+    };
+    std::map<const Room*, RoomLayoutCache> roomLayoutCache;
+    unsigned int roomLayoutGeneration; // Simulation world generation the cache belongs to
+    
+    // Adventure log wrapped to the panel width. Holds messages [wrappedFirstMessage, wrappedMessageEnd),
+    // with wrappedLineCounts recording how many lines each one took so they can be dropped from the front
+    struct LogLine {
+        std::string text;
+        Color color;
+    };
+    std::deque<LogLine> wrappedLog;
+    std::deque<int> wrappedLineCounts;
+    size_t wrappedFirstMessage;
+    size_t wrappedMessageEnd;
+    int wrappedWidth;
+    
+    // Rectangles, outlines and map links for the frame, drawn a layer at a time
+    QuadBatch quads;
+    QuadBatch::Stats lastFrameQuads;  // Counters for the previous frame, shown with F3
+    bool showRenderStats;
+    
+    // Retained UI panels: each is rendered into its own texture, again only when what it
+    // shows has changed, and composited every frame
+    struct PanelCache {
+        RenderTexture2D texture = {};
+        bool valid = false;
+    };
+    struct LogPanelKey {
+        int scrollOffset;
+        size_t firstMessage, messageEnd, lineCount;
+        bool operator!=(const LogPanelKey& other) const {
+            return scrollOffset != other.scrollOffset || firstMessage != other.firstMessage ||
+                   messageEnd != other.messageEnd || lineCount != other.lineCount;
+        }
+    };
+    struct StatsPanelKey {
+        int health;
+        int baseAttack, baseArmor;
+        int weaponIndex, armorIndex;
+        int weaponBonus = 0, armorBonus = 0;  // Of the equipped items
+        size_t inventorySize;
+        uint32_t shownItems[3] = {};  // Name ids of the items listed
+        bool operator==(const StatsPanelKey& other) const {
+            return health == other.health && baseAttack == other.baseAttack && baseArmor == other.baseArmor &&
+                   weaponIndex == other.weaponIndex && armorIndex == other.armorIndex &&
+                   weaponBonus == other.weaponBonus && armorBonus == other.armorBonus &&
+                   inventorySize == other.inventorySize && shownItems[0] == other.shownItems[0] &&
+                   shownItems[1] == other.shownItems[1] && shownItems[2] == other.shownItems[2];
+        }
+    };
+    PanelCache logPanel;
+    PanelCache inputPanel;
+    PanelCache statsPanel;
+    LogPanelKey logPanelKey;
+    std::string inputPanelText;
+    StatsPanelKey statsPanelKey;
+    
+    // A patch draws over what the panel already holds instead of starting from blank
+    void BeginPanelBake(PanelCache& panel, int x, int y, int width, int height, bool patch = false);
+    void EndPanelBake(PanelCache& panel);
+    void DrawPanel(const PanelCache& panel, int x, int y);
+    
+    // Character art (player walk frames, monsters, the stranger), rasterized once at startup
+    // so that every character on screen is a single textured quad
+    RenderTexture2D spriteAtlas;
+    
+    // DrawRoomLayout scratch: monsters whose sprite was drawn this frame, for the health passes
+    struct VisibleMonster {
+        size_t index;  // In GameState::monsters
+        int x, y;      // Sprite anchor on screen
+        int maxHealth;
+    };
+    std::vector<VisibleMonster> visibleMonsters;
     
     void DrawCurrentRoom();
     void DrawPlayer();
     void DrawRoomLayout(Room* room);
-    bool IsWalkable(int tileX, int tileY, Room* room);
-    void MovePlayer(float deltaX, float deltaY);
-    void UpdateMonsters();
-    void CheckMonsterCollisions();
-    float GetDistance(float x1, float y1, float x2, float y2);
-    void AttackNearestMonster();
+    void DrawRoomScenery(Room* room, int startX, int startY);
+    
+    // The atlas is premultiplied: draw sprites inside BeginBlendMode(BLEND_ALPHA_PREMULTIPLY)
+    void BakeSpriteAtlas();
+    void DrawSprite(int sprite, int x, int y);
+    void PaintPlayer(int playerPixelX, int playerPixelY, bool isFemale, int walkFrame);
+    void PaintMonster(int sprite, int monsterX, int monsterY);
+    void PaintStranger(int strangerX, int strangerY);
     void DrawPlayerStats();
-    int GetTotalAttack() const;
-    int GetTotalArmor() const;
-    Item* FindItemInInventory(const std::string& itemName);
-    int FindItemIndexInInventory(const std::string& itemName);
-    void EquipItem(const std::string& itemName);
-    void DropItem(const std::string& itemName);
-    void ShowItemStats(const std::string& itemName);
     void DrawDungeonMap();
-    void UseItem(const std::string& itemName);
-    void TeleportToRoom(const std::string& roomName);
+    
+    // Dungeon map layout, laid out from the rooms' exits, walking out from the entrance.
+    // Cells and links refer to rooms by id; the layout is rebuilt when a save is loaded.
+    enum class MapReveal {
+        ALWAYS,
+        INFIRMARY,  // Once the secret passage is open
+        MEADOW,     // Once the gem has been used
+        NOTE,       // Once the note has been read
+        KEY         // Once the key has been taken
+    };
+    struct MapCell {
+        int roomId;
+        int column, row;   // Grid square, counted from the top-left one in use
+        MapReveal reveal;
+        bool GameState::* staffPart = nullptr;  // Tinted while this part is still here
+        Color partColor = {};
+        Color partTextColor = {};
+    };
+    struct MapLink {
+        int fromCell, toCell;
+        MapReveal reveal;
+    };
+    std::vector<MapCell> mapCells;
+    std::vector<MapLink> mapLinks;
+    std::vector<int> mapCellForRoom;               // Cell index per room id
+    std::unordered_map<uint64_t, int> mapCellAt;   // Cell index per grid square, by MapSquareKey
+    std::vector<int> mapLinkStart;                 // Links touching cell i: mapLinkList[mapLinkStart[i], mapLinkStart[i + 1])
+    std::vector<int> mapLinkList;
+    int mapColumns, mapRows;
+    unsigned int mapGeneration;  // Simulation world generation the layout was built from
+    
+    // The part of the grid on screen. Cells are mapPitchX by mapPitchY pixels, boxes and
+    // gap included; only the cells wholly inside the view, and links between them, are drawn
+    float mapScale;
+    int mapPitchX, mapPitchY, mapGap;
+    int mapScrollX, mapScrollY;  // Pixels of the grid scrolled off the top left
+    int mapCentredRoom;          // Room the view last followed, or -1
+    std::vector<int> mapVisibleCells;
+    std::vector<int> mapVisibleLinks;
+    std::vector<bool> mapCellVisible;
+    
+    void BuildMapLayout();
+    void UpdateMapView();
+    void ScrollMap(int scrollX, int scrollY);
+    void FindVisibleMapCells();
+    int GetMapCellX(const MapCell& cell) const { return MAP_VIEW_X + cell.column * mapPitchX - mapScrollX; }
+    int GetMapCellY(const MapCell& cell) const { return MAP_VIEW_Y + cell.row * mapPitchY - mapScrollY; }
+    bool IsMapRevealed(MapReveal reveal) const;
+    bool IsMapLinkRevealed(const MapLink& link) const;
+    
+    // The map is kept in a texture and patched cell by cell; these record what each cell
+    // and link looked like when last drawn into it
+    struct MapCellLook {
+        bool revealed = false;
+        Color roomColor = {};
+        Color textColor = {};
+        bool operator!=(const MapCellLook& other) const {
+            return revealed != other.revealed ||
+                   roomColor.r != other.roomColor.r || roomColor.g != other.roomColor.g || roomColor.b != other.roomColor.b || roomColor.a != other.roomColor.a ||
+                   textColor.r != other.textColor.r || textColor.g != other.textColor.g || textColor.b != other.textColor.b || textColor.a != other.textColor.a;
+        }
+    };
+    PanelCache mapPanel;
+    std::vector<MapCellLook> mapCellsDrawn;
+    std::vector<bool> mapLinksDrawn;
+    std::vector<MapCellLook> mapCellLooks;  // DrawDungeonMap scratch: how each cell should look now
+    std::vector<int> mapChangedCells;       // DrawDungeonMap scratch: cells to draw again
+    std::vector<bool> mapLinksToDraw;       // DrawDungeonMap scratch
+    
+    MapCellLook GetMapCellLook(const MapCell& cell) const;
+    int FindMapCellAt(Vector2 point) const;
 };
\ No newline at end of file
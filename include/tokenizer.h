@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Splits text into words as string_views, dropping empty tokens. The token list (and,
+// for SplitLower, the lowercased copy of the text) is kept between calls, so once it
+// has grown to fit the longest input a tokenizer stops allocating altogether.
+// Returned tokens stay valid until the next call on the same tokenizer.
+class Tokenizer {
+public:
+    // Tokens point into text, which has to outlive them
+    const std::vector<std::string_view>& Split(std::string_view text, char delimiter);
+    
+    // Tokens point into a lowercased copy of text owned by the tokenizer
+    const std::vector<std::string_view>& SplitLower(std::string_view text, char delimiter);
+    
+private:
+    std::string lowered;
+    std::vector<std::string_view> tokens;
+};
\ No newline at end of file
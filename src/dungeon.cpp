@@ -1,10 +1,7 @@
 #include "dungeon.h"
-#include <cstdlib>
-#include <ctime>
 
-Dungeon::Dungeon() : wallColor({80, 60, 40, 255}), floorColor({120, 100, 80, 255}) {
+Dungeon::Dungeon(uint64_t seed) : wallColor({80, 60, 40, 255}), floorColor({120, 100, 80, 255}), rng(seed) {
     map.resize(MAP_HEIGHT, std::vector<int>(MAP_WIDTH, 0));
-    srand(time(nullptr));
 }
 
 void Dungeon::Generate() {
@@ -12,7 +9,7 @@ void Dungeon::Generate() {
         for (int x = 0; x < MAP_WIDTH; x++) {
             if (x == 0 || x == MAP_WIDTH - 1 || y == 0 || y == MAP_HEIGHT - 1) {
                 map[y][x] = 1;
-            } else if (rand() % 100 < 15) {
+            } else if (rng.NextInt(100) < 15) {
                 map[y][x] = 1;
             } else {
                 map[y][x] = 0;
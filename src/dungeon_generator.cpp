@@ -0,0 +1,260 @@
+#include "dungeon_generator.h"
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+
+static const int TILE_SIZE = RoomTheme::TILE_SIZE;
+static const int GRID_WIDTH = RoomTheme::GRID_WIDTH;
+static const int GRID_HEIGHT = RoomTheme::GRID_HEIGHT;
+
+// Kept apart from the game's own stream (see Generate)
+static const uint64_t DEPTHS_SEED_SALT = 0xD3E9755A1C0FFEE5ull;
+
+// Exits in the order rooms try to grow through them; OPPOSITE pairs them up
+static const char* const DIRECTIONS[4] = {"north", "east", "south", "west"};
+static const int DIRECTION_X[4] = {0, 1, 0, -1};
+static const int DIRECTION_Y[4] = {-1, 0, 1, 0};
+static const int OPPOSITE[4] = {2, 3, 0, 1};
+
+// One in LOOP_CHANCE pairs of neighbouring rooms not already joined get a door anyway
+static const int LOOP_CHANCE = 8;
+
+struct DepthsKind {
+    const char* noun;
+    const char* description;
+    PixelColor floor;
+    PixelColor obstacle;
+};
+
+static const DepthsKind KINDS[] = {
+    {"Cellar", "Low vaulted ceilings press down on you. Broken casks and crates are stacked against the walls.", {72, 60, 48, 255}, {110, 80, 50, 255}},
+    {"Crypt", "Stone coffins line the walls, their lids carved with worn faces. The air is cold and still.", {64, 64, 72, 255}, {120, 120, 130, 255}},
+    {"Cavern", "Rough rock walls glisten with moisture. Somewhere in the dark, water drips steadily.", {56, 52, 48, 255}, {90, 84, 76, 255}},
+    {"Gallery", "Faded murals cover the walls, showing battles no one remembers. Rubble has fallen from the ceiling.", {88, 76, 64, 255}, {130, 110, 90, 255}},
+    {"Storeroom", "Shelves sag under the weight of rotting sacks. Something has been gnawing at them.", {80, 68, 52, 255}, {120, 90, 60, 255}},
+    {"Shrine", "A small altar stands among toppled candle stands. The carvings on it have been chiselled away.", {72, 56, 72, 255}, {120, 100, 120, 255}},
+    {"Passage", "A long, narrow passage. The floor is worn smooth by countless feet.", {68, 68, 60, 255}, {100, 100, 90, 255}},
+    {"Cistern", "Dark water pools between stone pillars. Your footsteps echo back at you from every side.", {48, 60, 72, 255}, {80, 100, 120, 255}}
+};
+
+static const char* const ADJECTIVES[] = {
+    "Mossy", "Flooded", "Crumbling", "Silent", "Forgotten", "Echoing",
+    "Frozen", "Ashen", "Sunken", "Twisted", "Hollow", "Gloomy"
+};
+
+static const char* const ATMOSPHERES[] = {
+    "",
+    " A faint draught carries the smell of smoke.",
+    " Scratches on the floor lead into the shadows.",
+    " You hear something shuffling in the distance.",
+    " Cobwebs hang thick in every corner."
+};
+
+struct DepthsMonster {
+    const char* name;
+    const char* description;
+    int health;
+    int attack;
+    int minDepth;  // Rooms nearer the entrance than this never spawn it
+};
+
+static const DepthsMonster MONSTERS[] = {
+    {"rat", "A large, mangy rat with glowing red eyes.", 8, 3, 0},
+    {"goblin", "A small, green-skinned creature with sharp teeth and claws.", 15, 5, 3},
+    {"skeleton", "A rattling skeleton wielding a rusty sword.", 20, 8, 8}
+};
+
+struct DepthsLoot {
+    const char* name;
+    const char* description;
+    ItemType type;
+    int damageBonus;
+    int armorBonus;
+    int minDepth;
+};
+
+static const DepthsLoot LOOT[] = {
+    {"candle", "A stub of tallow candle.", ItemType::MISC, 0, 0, 0},
+    {"coins", "A handful of tarnished copper coins.", ItemType::MISC, 0, 0, 0},
+    {"dagger", "A short, well-balanced dagger.", ItemType::WEAPON, 2, 0, 0},
+    {"buckler", "A small round shield of hardened leather.", ItemType::ARMOR, 0, 1, 2},
+    {"mace", "A heavy iron mace, its head studded with spikes.", ItemType::WEAPON, 4, 0, 6},
+    {"helmet", "A dented but sturdy steel helmet.", ItemType::ARMOR, 0, 2, 10},
+    {"axe", "A double-headed war axe, still sharp.", ItemType::WEAPON, 6, 0, 20}
+};
+
+// Where RoomFactory and Simulation put the player on entering a room; kept clear
+static const int ARRIVAL_X = 10;
+static const int ARRIVAL_Y = 8;
+
+template <typename T, size_t N>
+static const T& Pick(Rng& rng, const T (&table)[N]) {
+    return table[rng.NextInt((int)N)];
+}
+
+std::vector<std::unique_ptr<Room>> DungeonGenerator::Generate(uint64_t seed, int roomCount) {
+    std::vector<std::unique_ptr<Room>> rooms;
+    if (roomCount <= 0) return rooms;
+    
+    Rng rng(seed ^ DEPTHS_SEED_SALT);
+    rooms.reserve(roomCount);
+    
+    // Grid layout: every room after the first is placed next to a random earlier one that
+    // still has a free side, and joined to it. open holds the rooms that might.
+    std::vector<int> gridX, gridY, depth;
+    gridX.reserve(roomCount);
+    gridY.reserve(roomCount);
+    depth.reserve(roomCount);
+    std::unordered_map<uint64_t, int> roomAt;
+    roomAt.reserve(roomCount * 2);
+    auto key = [](int x, int y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; };
+    
+    std::vector<int> open;
+    gridX.push_back(0);
+    gridY.push_back(0);
+    depth.push_back(0);
+    roomAt[key(0, 0)] = 0;
+    open.push_back(0);
+    std::vector<std::pair<int, int>> doors;  // (room, direction) pairs to join, in creation order
+    doors.reserve(roomCount * 2);
+    
+    while ((int)gridX.size() < roomCount) {
+        int slot = rng.NextInt((int)open.size());
+        int parent = open[slot];
+        
+        int freeSides[4];
+        int freeCount = 0;
+        for (int d = 0; d < 4; d++) {
+            if (!roomAt.count(key(gridX[parent] + DIRECTION_X[d], gridY[parent] + DIRECTION_Y[d]))) {
+                freeSides[freeCount++] = d;
+            }
+        }
+        if (freeCount == 0) {
+            open[slot] = open.back();
+            open.pop_back();
+            continue;
+        }
+        
+        int d = freeSides[rng.NextInt(freeCount)];
+        int child = (int)gridX.size();
+        gridX.push_back(gridX[parent] + DIRECTION_X[d]);
+        gridY.push_back(gridY[parent] + DIRECTION_Y[d]);
+        depth.push_back(depth[parent] + 1);
+        roomAt[key(gridX[child], gridY[child])] = child;
+        open.push_back(child);
+        doors.push_back({parent, d});
+    }
+    
+    for (int i = 0; i < roomCount; i++) {
+        rooms.push_back(CreateRoom(rng, i, depth[i]));
+    }
+    
+    for (const auto& door : doors) {
+        int from = door.first;
+        int d = door.second;
+        Room* to = rooms[roomAt[key(gridX[from] + DIRECTION_X[d], gridY[from] + DIRECTION_Y[d])]].get();
+        rooms[from]->SetExit(DIRECTIONS[d], to);
+        to->SetExit(DIRECTIONS[OPPOSITE[d]], rooms[from].get());
+    }
+    
+    // A few extra doors east and south between neighbours, so the Depths aren't a pure tree
+    for (int i = 0; i < roomCount; i++) {
+        for (int d = 1; d <= 2; d++) {
+            auto neighbour = roomAt.find(key(gridX[i] + DIRECTION_X[d], gridY[i] + DIRECTION_Y[d]));
+            if (neighbour == roomAt.end() || rooms[i]->GetExit(DIRECTIONS[d])) continue;
+            if (rng.NextInt(LOOP_CHANCE) != 0) continue;
+            Room* to = rooms[neighbour->second].get();
+            rooms[i]->SetExit(DIRECTIONS[d], to);
+            to->SetExit(DIRECTIONS[OPPOSITE[d]], rooms[i].get());
+        }
+    }
+    
+    return rooms;
+}
+
+std::unique_ptr<Room> DungeonGenerator::CreateRoom(Rng& rng, int index, int depth) {
+    const DepthsKind& kind = Pick(rng, KINDS);
+    
+    // Numbered, since thousands of rooms can't all have different names otherwise
+    std::string name = std::string(Pick(rng, ADJECTIVES)) + " " + kind.noun + " " + std::to_string(index + 1);
+    auto room = std::make_unique<Room>(name, std::string(kind.description) + Pick(rng, ATMOSPHERES));
+    
+    RoomTheme& theme = room->GetTheme();
+    int shade = rng.NextInt(17) - 8;  // So neighbouring rooms of one kind don't look identical
+    theme.SetFloorColor({(unsigned char)(kind.floor.r + shade), (unsigned char)(kind.floor.g + shade), (unsigned char)(kind.floor.b + shade), 255});
+    PixelColor edge = {(unsigned char)(kind.obstacle.r * 2 / 3), (unsigned char)(kind.obstacle.g * 2 / 3), (unsigned char)(kind.obstacle.b * 2 / 3), 255};
+    PlaceObstacles(rng, *room, kind.obstacle, edge);
+    room->BuildWalkMask();
+    
+    PlaceMonsters(rng, *room, depth);
+    PlaceLoot(rng, *room, depth);
+    return room;
+}
+
+void DungeonGenerator::PlaceObstacles(Rng& rng, Room& room, PixelColor color, PixelColor edgeColor) {
+    // Obstacles never touch the walls, the arrival tile or each other: with a free tile
+    // all round each one, every open tile in the room stays reachable
+    bool reserved[GRID_HEIGHT][GRID_WIDTH] = {};
+    for (int y = ARRIVAL_Y - 1; y <= ARRIVAL_Y + 2; y++) {
+        for (int x = ARRIVAL_X - 1; x <= ARRIVAL_X + 3; x++) {
+            reserved[y][x] = true;
+        }
+    }
+    
+    RoomTheme& theme = room.GetTheme();
+    int wanted = 2 + rng.NextInt(5);
+    for (int attempt = 0; attempt < wanted * 4 && wanted > 0; attempt++) {
+        int width = 1 + rng.NextInt(3);
+        int height = 1 + rng.NextInt(3);
+        int tileX = 2 + rng.NextInt(GRID_WIDTH - 4 - width + 1);
+        int tileY = 2 + rng.NextInt(GRID_HEIGHT - 4 - height + 1);
+        
+        bool clear = true;
+        for (int y = tileY; y < tileY + height && clear; y++) {
+            for (int x = tileX; x < tileX + width; x++) {
+                if (reserved[y][x]) {
+                    clear = false;
+                    break;
+                }
+            }
+        }
+        if (!clear) continue;
+        
+        for (int y = tileY - 1; y <= tileY + height; y++) {
+            for (int x = tileX - 1; x <= tileX + width; x++) {
+                reserved[y][x] = true;
+            }
+        }
+        theme.AddObstacle(tileX, tileY, width, height, color);
+        theme.AddOutline(tileX * TILE_SIZE, tileY * TILE_SIZE, width * TILE_SIZE, height * TILE_SIZE, edgeColor);
+        wanted--;
+    }
+}
+
+void DungeonGenerator::PlaceMonsters(Rng& rng, Room& room, int depth) {
+    int count = rng.NextInt(3 + std::min(depth / 10, 3));
+    int toughness = depth / 5;  // Extra health and attack the deeper you go
+    
+    for (int i = 0; i < count; i++) {
+        const DepthsMonster* kind = &Pick(rng, MONSTERS);
+        while (kind->minDepth > depth) kind--;
+        
+        // Somewhere walkable, inside the wander bounds and out of aggro range of the door
+        for (int attempt = 0; attempt < 16; attempt++) {
+            int x = 2 + rng.NextInt(GRID_WIDTH - 4);
+            int y = 2 + rng.NextInt(GRID_HEIGHT - 4);
+            if (!room.IsWalkable(x, y) || std::abs(x - ARRIVAL_X) + std::abs(y - ARRIVAL_Y) < 6) continue;
+            room.AddMonster(Monster(kind->name, kind->description, kind->health + toughness * 2, kind->attack + toughness, (float)x, (float)y));
+            break;
+        }
+    }
+}
+
+void DungeonGenerator::PlaceLoot(Rng& rng, Room& room, int depth) {
+    if (rng.NextInt(3) != 0) return;
+    
+    const DepthsLoot* loot = &Pick(rng, LOOT);
+    while (loot->minDepth > depth) loot--;
+    room.AddItem(Item(loot->name, loot->description, true, loot->type, loot->damageBonus, loot->armorBonus));
+}
\ No newline at end of file
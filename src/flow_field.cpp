@@ -0,0 +1,75 @@
+#include "flow_field.h"
+#include <cstdlib>
+#include <utility>
+
+FlowField::FlowField() : roomId(-1), goalX(-1), goalY(-1) {
+    for (auto& row : distance) {
+        for (auto& cell : row) {
+            cell = UNREACHABLE;
+        }
+    }
+}
+
+void FlowField::Update(const Room& room, int newGoalX, int newGoalY) {
+    if (room.GetId() == roomId && newGoalX == goalX && newGoalY == goalY) return;
+    roomId = room.GetId();
+    goalX = newGoalX;
+    goalY = newGoalY;
+    
+    for (auto& row : distance) {
+        for (auto& cell : row) {
+            cell = UNREACHABLE;
+        }
+    }
+    if ((unsigned)goalX >= (unsigned)WIDTH || (unsigned)goalY >= (unsigned)HEIGHT) return;
+    
+    // Every tile is queued at most once, so a fixed ring of WIDTH * HEIGHT entries is enough
+    static const int DX[4] = {-1, 1, 0, 0};
+    static const int DY[4] = {0, 0, -1, 1};
+    uint16_t queue[WIDTH * HEIGHT];
+    int head = 0, tail = 0;
+    distance[goalY][goalX] = 0;
+    queue[tail++] = (uint16_t)(goalY * WIDTH + goalX);
+    
+    while (head < tail) {
+        int x = queue[head] % WIDTH;
+        int y = queue[head] / WIDTH;
+        head++;
+        uint16_t next = distance[y][x] + 1;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + DX[d];
+            int ny = y + DY[d];
+            if (!room.IsWalkable(nx, ny) || distance[ny][nx] != UNREACHABLE) continue;
+            distance[ny][nx] = next;
+            queue[tail++] = (uint16_t)(ny * WIDTH + nx);
+        }
+    }
+}
+
+bool FlowField::NextStep(int tileX, int tileY, int& stepX, int& stepY) const {
+    uint16_t here = GetDistance(tileX, tileY);
+    if (here == 0) return false;
+    
+    // Towards the goal on the major axis, then the minor one, then away on each
+    int dx = goalX - tileX;
+    int dy = goalY - tileY;
+    int signX = dx < 0 ? -1 : 1;
+    int signY = dy < 0 ? -1 : 1;
+    int order[4][2] = {{signX, 0}, {0, signY}, {0, -signY}, {-signX, 0}};
+    if (std::abs(dx) <= std::abs(dy)) {
+        std::swap(order[0], order[1]);
+        std::swap(order[2], order[3]);
+    }
+    
+    // The first neighbour, in that order, with the smallest distance
+    uint16_t best = here;
+    for (auto& step : order) {
+        uint16_t candidate = GetDistance(tileX + step[0], tileY + step[1]);
+        if (candidate < best) {
+            best = candidate;
+            stepX = tileX + step[0];
+            stepY = tileY + step[1];
+        }
+    }
+    return best < here;
+}
\ No newline at end of file
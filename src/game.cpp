@@ -1,6 +1,7 @@
 #include "game.h"
+#include <ctime>
 
-Game::Game() : player(Vector2{100, 100}) {
+Game::Game() : player(Vector2{100, 100}), dungeon((uint64_t)time(nullptr)) {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Retro Dungeon");
     SetTargetFPS(60);
     
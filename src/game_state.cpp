@@ -0,0 +1,32 @@
+#include "game_state.h"
+
+GameState::GameState() : currentRoom(nullptr), playerHealth(100), basePlayerAttack(3), basePlayerArmor(1), equippedWeaponIndex(-1), equippedArmorIndex(-1), playerRoomX(12.0f), playerRoomY(9.0f), prevPlayerRoomX(12.0f), prevPlayerRoomY(9.0f), playerSpeed(4.0f), isFemale(false), moveTicks(0), walkAnimFrame(0), animTicks(0), isWalking(false), bookTaken(false), scrollTaken(false), mapUnlocked(false), infirmaryRevealed(false), inMapView(false), hasKey(false), gemUsed(false), hasTeleport(false), strangeMet(false), noteRead(false), hasStaff(false), hasDiamond(false), hasEmerald(false), hasOpal(false), staffComplete(false), gameEnding(false), shouldQuit(false), waitingForContinue(false), endingPhase(0), endingTicks(0), tick(0), lastMonsterAttackTick(0) {}
+
+int GameState::GetTotalAttack() const {
+    int total = basePlayerAttack;
+    if (equippedWeaponIndex >= 0 && equippedWeaponIndex < (int)inventory.size()) {
+        total += inventory[equippedWeaponIndex].damageBonus;
+    }
+    return total;
+}
+
+int GameState::GetTotalArmor() const {
+    int total = basePlayerArmor;
+    if (equippedArmorIndex >= 0 && equippedArmorIndex < (int)inventory.size()) {
+        total += inventory[equippedArmorIndex].armorBonus;
+    }
+    return total;
+}
+
+void GameState::IndexRooms() {
+    roomsByName.clear();
+    for (size_t i = 0; i < rooms.size(); i++) {
+        rooms[i]->SetId((int)i);
+        roomsByName[rooms[i]->GetName().GetId()] = rooms[i].get();
+    }
+}
+
+Room* GameState::FindRoom(Name name) const {
+    auto it = roomsByName.find(name.GetId());
+    return it != roomsByName.end() ? it->second : nullptr;
+}
\ No newline at end of file
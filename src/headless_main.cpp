@@ -0,0 +1,91 @@
+#include "headless_runner.h"
+#include "launch_options.h"
+#include "replay.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static const char* USAGE =
+    "usage: retro_dungeon_headless [--quiet] [--seed N] [--record FILE] [script]  plays a script (or stdin) without a window\n"
+    "       retro_dungeon_headless [--quiet] --replay FILE                        reruns a recorded session\n"
+    "  --load FILE  start the script from a saved snapshot instead of a new game\n"
+    "  --save FILE  write a snapshot once the script has finished\n"
+    "  --depths N   generate N extra rooms below the basement\n";
+
+int main(int argc, char** argv) {
+    LaunchOptions options;
+    unsigned accepted = LaunchOptions::QUIET | LaunchOptions::SEED | LaunchOptions::RECORD | LaunchOptions::REPLAY | LaunchOptions::LOAD | LaunchOptions::SAVE | LaunchOptions::DEPTHS | LaunchOptions::SCRIPT;
+    if (!options.Parse(argc, argv, accepted, USAGE)) {
+        return 2;
+    }
+    
+    ReplayPlayer replay;
+    if (!options.replayPath.empty()) {
+        if (!replay.Open(options.replayPath)) {
+            std::cerr << "Cannot read replay " << options.replayPath << std::endl;
+            return 2;
+        }
+        options.seed = replay.GetSeed();
+        options.depthRooms = replay.GetDepthRooms();
+    }
+    
+    // Headless sessions keep the bounded log but never spill it, so many can run side by side
+    Simulation simulation("", options.seed, options.depthRooms);
+    if (!options.quiet) {
+        for (size_t i = 0; i < simulation.GetLog().GetTotalCount(); ++i) {
+            std::cout << simulation.GetLog().Get(i) << "\n";
+        }
+        simulation.SetEcho(&std::cout);
+    }
+    
+    if (!options.replayPath.empty()) {
+        if (!replay.Play(simulation)) {
+            std::cerr << "Replay " << options.replayPath << " is corrupt at tick " << simulation.GetState().tick << std::endl;
+            return 2;
+        }
+        const GameState& state = simulation.GetState();
+        std::cout << "[replay] " << state.currentRoom->GetName().GetText() << ", health " << state.playerHealth << ", " << state.tick << " ticks" << std::endl;
+        return 0;
+    }
+    
+    if (!options.loadPath.empty()) {
+        // Replays always start from a new game, so a resumed session can't be recorded
+        if (!options.recordPath.empty()) {
+            std::cerr << "--record cannot be combined with --load" << std::endl;
+            return 2;
+        }
+        if (!simulation.LoadSnapshot(options.loadPath)) {
+            std::cerr << "Cannot load snapshot " << options.loadPath << std::endl;
+            return 2;
+        }
+    }
+    
+    ReplayWriter recorder;
+    if (!options.recordPath.empty()) {
+        if (!recorder.Open(options.recordPath, options.seed, options.depthRooms)) {
+            std::cerr << "Cannot write replay " << options.recordPath << std::endl;
+            return 2;
+        }
+        simulation.SetRecorder(&recorder);
+    }
+    
+    HeadlessRunner runner(simulation);
+    int result = 2;
+    if (options.scriptPath.empty()) {
+        result = runner.Run(std::cin);
+    } else {
+        std::ifstream script(options.scriptPath);
+        if (script) {
+            result = runner.Run(script);
+        } else {
+            std::cerr << "Cannot open script " << options.scriptPath << std::endl;
+        }
+    }
+    
+    recorder.Close(simulation.GetState().tick);
+    if (!options.savePath.empty() && !simulation.SaveSnapshot(options.savePath)) {
+        std::cerr << "Cannot write snapshot " << options.savePath << std::endl;
+        return 2;
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "headless_runner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// The whole of text as a finite, non-negative number of seconds
+static bool ParseSeconds(std::string_view text, float& seconds) {
+    std::string copy(text);
+    char* end = nullptr;
+    seconds = std::strtof(copy.c_str(), &end);
+    return !copy.empty() && end == copy.c_str() + copy.size() && std::isfinite(seconds) && seconds >= 0.0f;
+}
+
+HeadlessRunner::HeadlessRunner(Simulation& simulation) : simulation(simulation) {}
+
+void HeadlessRunner::RunTicks(float seconds, const TickInput& input) {
+    TickInput held = input;
+    // Clamped in floating point, so a huge wait can't overflow the count
+    int ticks = (int)std::clamp(std::round((double)seconds * Simulation::TICK_RATE), 1.0, (double)Simulation::MAX_WAIT_TICKS);
+    for (int i = 0; i < ticks; i++) {
+        simulation.Tick(held);
+        // Presses only count on the first step; held directions carry on
+        held.attack = false;
+        held.closeMap = false;
+    }
+}
+
+int HeadlessRunner::Run(std::istream& script) {
+    const MessageLog& log = simulation.GetLog();
+    const GameState& state = simulation.GetState();
+    
+    int failures = 0;
+    int lineNumber = 0;
+    size_t lastLineFirstMessage = log.GetTotalCount();
+    std::string line;
+    while (!state.shouldQuit && std::getline(script, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        
+        size_t firstMessage = log.GetTotalCount();
+        
+        if (line[0] != ':') {
+            simulation.SubmitCommand(line);
+            // Typing a command takes a step like any other frame
+            RunTicks(Simulation::TICK_SECONDS, TickInput());
+            lastLineFirstMessage = firstMessage;
+            continue;
+        }
+        
+        const std::vector<std::string_view>& words = tokenizer.SplitLower(std::string_view(line).substr(1), ' ');
+        std::string_view directive = words.empty() ? std::string_view() : words[0];
+        
+        // Both timed directives end in a duration
+        float seconds = 0.0f;
+        bool timed = (directive == "wait" && words.size() > 1) || (directive == "hold" && words.size() > 2);
+        if (timed && !ParseSeconds(words[directive == "wait" ? 1 : 2], seconds)) {
+            std::cerr << "line " << lineNumber << ": bad duration in \"" << line << "\"" << std::endl;
+            failures++;
+            continue;
+        }
+        
+        if (directive == "wait" && words.size() > 1) {
+            RunTicks(seconds, TickInput());
+        }
+        else if (directive == "hold" && words.size() > 2) {
+            TickInput input;
+            input.up = (words[1] == "up");
+            input.down = (words[1] == "down");
+            input.left = (words[1] == "left");
+            input.right = (words[1] == "right");
+            if (!input.up && !input.down && !input.left && !input.right) {
+                std::cerr << "line " << lineNumber << ": unknown direction in \"" << line << "\"" << std::endl;
+                failures++;
+                continue;
+            }
+            RunTicks(seconds, input);
+        }
+        else if (directive == "attack") {
+            TickInput input;
+            input.attack = true;
+            RunTicks(Simulation::TICK_SECONDS, input);
+        }
+        else if (directive == "closemap") {
+            TickInput input;
+            input.closeMap = true;
+            RunTicks(Simulation::TICK_SECONDS, input);
+        }
+        else if (directive == "expect" && words.size() > 1) {
+            // Everything from the first word after the directive, split again to keep its case
+            std::string_view text = std::string_view(line).substr(1);
+            const std::vector<std::string_view>& original = tokenizer.Split(text, ' ');
+            std::string expected(original[1].data(), text.data() + text.size() - original[1].data());
+            bool found = false;
+            for (size_t i = std::max(lastLineFirstMessage, log.GetFirstInMemory()); i < log.GetTotalCount() && !found; ++i) {
+                found = (log.Get(i).find(expected) != std::string::npos);
+            }
+            if (!found) {
+                std::cerr << "line " << lineNumber << ": expected \"" << expected << "\"" << std::endl;
+                failures++;
+            }
+            continue;
+        }
+        else {
+            std::cerr << "line " << lineNumber << ": unknown directive \"" << line << "\"" << std::endl;
+            failures++;
+            continue;
+        }
+        lastLineFirstMessage = firstMessage;
+    }
+    
+    std::cout << "[headless] " << state.currentRoom->GetName().GetText() << ", health " << state.playerHealth << ", " << (double)state.tick / Simulation::TICK_RATE << "s simulated, " << failures << " failure(s)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "launch_options.h"
+#include "simulation.h"
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+
+bool LaunchOptions::ParseNumber(const char* text, uint64_t& value) {
+    if (*text < '0' || *text > '9') return false;
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoull(text, &end, 10);
+    return errno == 0 && *end == '\0';
+}
+
+bool LaunchOptions::Parse(int argc, char** argv, unsigned accepted, const char* usage) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        uint64_t number = 0;
+        bool valid = true;
+        if (arg == "--quiet" && (accepted & QUIET)) quiet = true;
+        else if (arg == "--seed" && (accepted & SEED) && hasValue) valid = ParseNumber(argv[++i], seed);
+        else if (arg == "--record" && (accepted & RECORD) && hasValue) recordPath = argv[++i];
+        else if (arg == "--replay" && (accepted & REPLAY) && hasValue) replayPath = argv[++i];
+        else if (arg == "--load" && (accepted & LOAD) && hasValue) loadPath = argv[++i];
+        else if (arg == "--save" && (accepted & SAVE) && hasValue) savePath = argv[++i];
+        else if (arg == "--depths" && (accepted & DEPTHS) && hasValue) {
+            valid = ParseNumber(argv[++i], number);
+            if (valid && number > (uint64_t)Simulation::MAX_DEPTH_ROOMS) {
+                std::cerr << "--depths must be between 0 and " << Simulation::MAX_DEPTH_ROOMS << "\n" << usage;
+                return false;
+            }
+            depthRooms = (int)number;
+        }
+        else if (arg.compare(0, 2, "--") != 0 && (accepted & SCRIPT) && scriptPath.empty()) scriptPath = arg;
+        else valid = false;
+        
+        if (!valid) {
+            std::cerr << "bad argument \"" << argv[i] << "\"\n" << usage;
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -1,7 +1,18 @@
+#include "launch_options.h"
 #include "textadventure.h"
 
-int main() {
-    TextAdventure game;
+static const char* USAGE =
+    "usage: retro_dungeon [--record FILE] [--depths N]\n"
+    "  --record FILE  record the session for retro_dungeon_headless --replay\n"
+    "  --depths N     generate N extra rooms below the basement\n";
+
+int main(int argc, char** argv) {
+    LaunchOptions options;
+    if (!options.Parse(argc, argv, LaunchOptions::RECORD | LaunchOptions::DEPTHS, USAGE)) {
+        return 2;
+    }
+    
+    TextAdventure game(options.recordPath, options.depthRooms);
     game.Run();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "message_log.h"
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+
+MessageLog::MessageLog(size_t capacity, const std::string& spillPath) : ring(std::max<size_t>(capacity, 1)), head(0), count(0), spilledCount(0), spillPath(spillPath), spillEnd(0), cursorIndex(0), cursorOffset(0) {
+    if (!spillPath.empty()) {
+        // Each session starts a fresh spill file
+        spillFile.open(spillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    }
+}
+
+MessageLog::~MessageLog() {
+    if (!spillPath.empty()) {
+        spillFile.close();
+        std::remove(spillPath.c_str());
+    }
+}
+
+void MessageLog::Add(const std::string& message) {
+    if (count == ring.size()) {
+        // The file is walked back from its end, so one missing record would shift every
+        // older message onto the wrong index; after a failed write, history before the
+        // window is forgotten instead, as it is without a spill file
+        if (!Spill(ring[head])) {
+            spillFile.close();
+        }
+        ring[head] = message;
+        head = (head + 1) % ring.size();
+        spilledCount++;
+    } else {
+        ring[(head + count) % ring.size()] = message;
+        count++;
+    }
+}
+
+const std::string& MessageLog::Get(size_t index) const {
+    return ring[(head + (index - spilledCount)) % ring.size()];
+}
+
+bool MessageLog::Spill(const std::string& message) {
+    if (!spillFile.is_open()) {
+        return false;
+    }
+
+    uint32_t length = (uint32_t)message.size();
+    spillFile.clear();
+    spillFile.seekp(spillEnd);
+    spillFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    spillFile.write(message.data(), length);
+    spillFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    if (!spillFile) {
+        return false;
+    }
+    spillEnd += (std::streamoff)(2 * sizeof(length) + length);
+    return true;
+}
+
+bool MessageLog::ReadRecordBefore(std::streamoff& offset, std::string* message) const {
+    uint32_t length = 0;
+    if (offset < (std::streamoff)sizeof(length)) {
+        return false;
+    }
+
+    spillFile.clear();
+    spillFile.seekg(offset - (std::streamoff)sizeof(length));
+    if (!spillFile.read(reinterpret_cast<char*>(&length), sizeof(length))) {
+        return false;
+    }
+
+    std::streamoff start = offset - (std::streamoff)(2 * sizeof(length) + length);
+    if (start < 0) {
+        return false;
+    }
+
+    if (message) {
+        message->resize(length);
+        spillFile.seekg(start + (std::streamoff)sizeof(length));
+        if (!spillFile.read(&(*message)[0], length)) {
+            return false;
+        }
+    }
+    offset = start;
+    return true;
+}
+
+std::vector<std::string> MessageLog::LoadSpilled(size_t endIndex, size_t maxCount) const {
+    std::vector<std::string> loaded;
+    endIndex = std::min(endIndex, spilledCount);
+    if (!spillFile.is_open() || endIndex == 0 || maxCount == 0) {
+        return loaded;
+    }
+
+    // Walk back from the end of the file, or from the last page if that is closer
+    size_t index = spilledCount;
+    std::streamoff offset = spillEnd;
+    if (cursorIndex >= endIndex && cursorIndex < index) {
+        index = cursorIndex;
+        offset = cursorOffset;
+    }
+    while (index > endIndex) {
+        if (!ReadRecordBefore(offset, nullptr)) {
+            return loaded;
+        }
+        index--;
+    }
+
+    size_t wanted = std::min(maxCount, endIndex);
+    loaded.resize(wanted);
+    size_t read = 0;
+    while (read < wanted) {
+        if (!ReadRecordBefore(offset, &loaded[wanted - 1 - read])) {
+            break;
+        }
+        read++;
+    }
+
+    // A short read leaves the oldest slots empty; drop them rather than show blanks
+    loaded.erase(loaded.begin(), loaded.begin() + (wanted - read));
+    cursorIndex = endIndex - read;
+    cursorOffset = offset;
+    return loaded;
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "monster_store.h"
+
+static inline void AggroStep(size_t i, const float* __restrict x, const float* __restrict y, const float* __restrict aggroRange, const uint8_t* __restrict alive, int32_t* __restrict moveTicks, uint8_t* __restrict isAggro, float* __restrict distSquared, float playerX, float playerY) {
+    float dx = playerX - x[i];
+    float dy = playerY - y[i];
+    float d2 = dx * dx + dy * dy;
+    distSquared[i] = d2;
+    moveTicks[i] += alive[i];
+    
+    // Check if player is in aggro range
+    isAggro[i] |= alive[i] & (uint8_t)(d2 <= aggroRange[i] * aggroRange[i]);
+}
+
+// Branch-free over flat arrays that never alias, so the compiler can vectorize it. Kept out
+// of line: once inlined into UpdateAggro GCC forgets the arrays don't overlap.
+void MonsterStore::AggroKernel(size_t count, const float* __restrict x, const float* __restrict y, const float* __restrict aggroRange, const uint8_t* __restrict alive, int32_t* __restrict moveTicks, uint8_t* __restrict isAggro, float* __restrict distSquared, float playerX, float playerY) {
+    // Fixed-width blocks get vectorized even under -O2's cost model; the remainder runs scalar
+    const size_t BLOCK = 16;
+    size_t i = 0;
+    for (; i + BLOCK <= count; i += BLOCK) {
+        for (size_t j = i; j < i + BLOCK; j++) {
+            AggroStep(j, x, y, aggroRange, alive, moveTicks, isAggro, distSquared, playerX, playerY);
+        }
+    }
+    for (; i < count; i++) {
+        AggroStep(i, x, y, aggroRange, alive, moveTicks, isAggro, distSquared, playerX, playerY);
+    }
+}
+
+void MonsterStore::Build(std::vector<std::unique_ptr<Room>>& rooms) {
+    *this = MonsterStore();
+    roomFirst.reserve(rooms.size() + 1);
+    for (auto& room : rooms) {
+        roomFirst.push_back(Size());
+        for (const auto& monster : room->TakeSpawns()) {
+            Add(monster);
+        }
+    }
+    roomFirst.push_back(Size());
+    
+    cellHead.assign(rooms.size() * GRID_CELLS, NO_MONSTER);
+    nextInCell.resize(Size());
+    cellOf.resize(Size());
+    for (size_t roomId = 0; roomId < rooms.size(); roomId++) {
+        for (size_t i = RoomBegin((int)roomId); i < RoomEnd((int)roomId); i++) {
+            AddToCell(i, CellOf((int)roomId, x[i], y[i]));
+        }
+    }
+}
+
+void MonsterStore::Add(const Monster& monster) {
+    x.push_back(monster.x);
+    y.push_back(monster.y);
+    prevX.push_back(monster.prevX);
+    prevY.push_back(monster.prevY);
+    aggroRange.push_back(monster.aggroRange);
+    moveTicks.push_back(monster.moveTicks);
+    alive.push_back(monster.alive);
+    isAggro.push_back(monster.isAggro);
+    targetX.push_back(monster.targetX);
+    targetY.push_back(monster.targetY);
+    health.push_back(monster.health);
+    attack.push_back(monster.attack);
+    name.push_back(monster.name);
+    description.push_back(monster.description);
+}
+
+Monster MonsterStore::Get(size_t index) const {
+    Monster monster(name[index].GetText(), description[index], health[index], attack[index], x[index], y[index]);
+    monster.alive = alive[index];
+    monster.targetX = targetX[index];
+    monster.targetY = targetY[index];
+    monster.prevX = prevX[index];
+    monster.prevY = prevY[index];
+    monster.moveTicks = moveTicks[index];
+    monster.aggroRange = aggroRange[index];
+    monster.isAggro = isAggro[index];
+    return monster;
+}
+
+void MonsterStore::UpdateAggro(size_t first, size_t last, float playerX, float playerY, float* distSquared) {
+    AggroKernel(last - first, &x[first], &y[first], &aggroRange[first], &alive[first], &moveTicks[first], &isAggro[first], distSquared, playerX, playerY);
+}
+
+void MonsterStore::SetPosition(size_t index, float newX, float newY) {
+    x[index] = newX;
+    y[index] = newY;
+    
+    uint32_t cell = CellOf((int)(cellOf[index] / GRID_CELLS), newX, newY);
+    if (cell != cellOf[index]) {
+        RemoveFromCell(index, cellOf[index]);
+        AddToCell(index, cell);
+    }
+}
+
+size_t MonsterStore::FindNearest(int roomId, float px, float py, float radius) const {
+    size_t closest = Size();
+    float closestSquared = radius * radius;
+    ForEachWithin(roomId, px, py, radius, [&](size_t i) {
+        float dx = px - x[i];
+        float dy = py - y[i];
+        float distanceSquared = dx * dx + dy * dy;
+        // Strictly inside the radius; among equals the lowest index wins, whatever the visit order
+        if (distanceSquared < closestSquared || (distanceSquared == closestSquared && closest != Size() && i < closest)) {
+            closestSquared = distanceSquared;
+            closest = i;
+        }
+    });
+    return closest;
+}
+
+void MonsterStore::AddToCell(size_t index, uint32_t cell) {
+    nextInCell[index] = cellHead[cell];
+    cellHead[cell] = (uint32_t)index;
+    cellOf[index] = cell;
+}
+
+void MonsterStore::RemoveFromCell(size_t index, uint32_t cell) {
+    for (uint32_t* link = &cellHead[cell]; *link != NO_MONSTER; link = &nextInCell[*link]) {
+        if (*link == index) {
+            *link = nextInCell[index];
+            return;
+        }
+    }
+}
+
+uint32_t MonsterStore::CellOf(int roomId, float px, float py) const {
+    int column = std::min(std::max((int)std::floor(px / GRID_CELL_TILES), 0), GRID_COLUMNS - 1);
+    int row = std::min(std::max((int)std::floor(py / GRID_CELL_TILES), 0), GRID_ROWS - 1);
+    return (uint32_t)roomId * GRID_CELLS + row * GRID_COLUMNS + column;
+}
\ No newline at end of file
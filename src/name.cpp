@@ -0,0 +1,79 @@
+#include "name.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+// One table for the whole process; ids are never reused or freed. The deque keeps each
+// string at a fixed address, so the index can key on views into it and the pages can
+// point at it. Only Intern and Find take the mutex: GetText reads through the pages,
+// which are allocated once and never move, so a lookup can't race an insert.
+struct NameTable {
+    static const uint32_t PAGE_BITS = 16;
+    static const uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+    static const uint32_t PAGE_COUNT = 1u << (32 - PAGE_BITS);  // Enough for every id
+    typedef std::atomic<const std::string*> Page[PAGE_SIZE];
+    
+    std::mutex mutex;
+    std::deque<std::string> texts{""};
+    std::unordered_map<std::string_view, uint32_t> ids{{texts.front(), 0}};
+    std::atomic<Page*> pages[PAGE_COUNT] = {};
+    
+    NameTable() { Publish(0); }
+    ~NameTable() {
+        for (std::atomic<Page*>& page : pages) delete[] page.load();
+    }
+    
+    // Makes texts[id] visible to GetText; called with the mutex held
+    void Publish(uint32_t id) {
+        std::atomic<Page*>& page = pages[id >> PAGE_BITS];
+        if (!page.load(std::memory_order_relaxed)) {
+            page.store(new Page[1](), std::memory_order_release);
+        }
+        (*page.load(std::memory_order_relaxed))[id & (PAGE_SIZE - 1)].store(&texts[id], std::memory_order_release);
+    }
+    
+    const std::string& Get(uint32_t id) const {
+        const Page* page = pages[id >> PAGE_BITS].load(std::memory_order_acquire);
+        return *(*page)[id & (PAGE_SIZE - 1)].load(std::memory_order_acquire);
+    }
+};
+
+static NameTable& GetTable() {
+    static NameTable table;
+    return table;
+}
+
+uint32_t Name::Intern(std::string_view text) {
+    NameTable& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    
+    auto it = table.ids.find(text);
+    if (it != table.ids.end()) {
+        return it->second;
+    }
+    uint32_t id = (uint32_t)table.texts.size();
+    table.texts.emplace_back(text);
+    table.ids.emplace(table.texts.back(), id);
+    table.Publish(id);
+    return id;
+}
+
+Name Name::Find(std::string_view text) {
+    NameTable& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    
+    Name name;
+    auto it = table.ids.find(text);
+    name.id = (it != table.ids.end()) ? it->second : NONE;
+    return name;
+}
+
+const std::string& Name::GetText() const {
+    static const std::string unknown;
+    if (id == NONE) {
+        return unknown;
+    }
+    
+    return GetTable().Get(id);
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "quad_batch.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+void QuadBatch::Rect(int x, int y, int width, int height, Color color) {
+    AddRect(x, y, width, height, color);
+    stats.primitives++;
+}
+
+void QuadBatch::Outline(int x, int y, int width, int height, Color color) {
+    if (width <= 0 || height <= 0) return;
+    
+    // One pixel wide, just inside the rectangle; the sides skip the corners the top and bottom already cover
+    AddRect(x, y, width, 1, color);
+    AddRect(x, y + height - 1, width, 1, color);
+    AddRect(x, y + 1, 1, height - 2, color);
+    AddRect(x + width - 1, y + 1, 1, height - 2, color);
+    stats.primitives++;
+}
+
+void QuadBatch::Line(Vector2 from, Vector2 to, float thickness, Color color) {
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+    
+    // Half the thickness either side, perpendicular to the line
+    float nx = -dy / length * thickness * 0.5f;
+    float ny = dx / length * thickness * 0.5f;
+    AddQuad({from.x - nx, from.y - ny}, {from.x + nx, from.y + ny}, {to.x + nx, to.y + ny}, {to.x - nx, to.y - ny}, color);
+    stats.primitives++;
+}
+
+void QuadBatch::AddRect(int x, int y, int width, int height, Color color) {
+    if (width <= 0 || height <= 0) return;
+    float left = (float)x, top = (float)y;
+    float right = (float)(x + width), bottom = (float)(y + height);
+    AddQuad({left, top}, {left, bottom}, {right, bottom}, {right, top}, color);
+}
+
+void QuadBatch::AddQuad(Vector2 a, Vector2 b, Vector2 c, Vector2 d, Color color) {
+    vertices.push_back({a.x, a.y, color});
+    vertices.push_back({b.x, b.y, color});
+    vertices.push_back({c.x, c.y, color});
+    vertices.push_back({d.x, d.y, color});
+}
+
+void QuadBatch::Flush() {
+    if (vertices.empty()) return;
+    
+    // Quads are drawn with rlgl's 1x1 white texture, as raylib's own shapes are, so a
+    // layer only breaks raylib's batch where the texture really changes (around text)
+    for (size_t start = 0; start < vertices.size(); start += MAX_SUBMIT_VERTICES) {
+        size_t end = std::min(vertices.size(), start + (size_t)MAX_SUBMIT_VERTICES);
+        
+        // Makes room in rlgl's buffer first, drawing what it held if this wouldn't fit
+        rlCheckRenderBatchLimit((int)(end - start));
+        
+        rlSetTexture(rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (size_t i = start; i < end; i++) {
+            const Vertex& vertex = vertices[i];
+            rlColor4ub(vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a);
+            rlTexCoord2f(0.0f, 0.0f);
+            rlVertex2f(vertex.x, vertex.y);
+        }
+        rlEnd();
+        rlSetTexture(0);
+        
+        stats.submissions++;
+    }
+    
+    stats.vertices += (int)vertices.size();
+    vertices.clear();
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "replay.h"
+#include <algorithm>
+
+static const char REPLAY_MAGIC[4] = {'R', 'D', 'R', 'P'};
+static const uint8_t REPLAY_VERSION = 2;  // Older files are rejected rather than guessed at
+
+static uint8_t InputToMask(const TickInput& input) {
+    return (input.up ? 1 : 0) | (input.down ? 2 : 0) | (input.left ? 4 : 0) |
+           (input.right ? 8 : 0) | (input.attack ? 16 : 0) | (input.closeMap ? 32 : 0);
+}
+
+static TickInput MaskToInput(uint8_t mask) {
+    TickInput input;
+    input.up = (mask & 1) != 0;
+    input.down = (mask & 2) != 0;
+    input.left = (mask & 4) != 0;
+    input.right = (mask & 8) != 0;
+    input.attack = (mask & 16) != 0;
+    input.closeMap = (mask & 32) != 0;
+    return input;
+}
+
+ReplayWriter::ReplayWriter() : lastTick(0), lastInputMask(0) {}
+
+bool ReplayWriter::Open(const std::string& path, uint64_t seed, int depthRooms) {
+    file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    
+    file.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    file.put((char)REPLAY_VERSION);
+    for (int i = 0; i < 8; i++) {
+        file.put((char)(seed >> (i * 8)));
+    }
+    WriteVarint((uint64_t)depthRooms);
+    lastTick = 0;
+    lastInputMask = 0;
+    return true;
+}
+
+void ReplayWriter::Close(uint64_t finalTick) {
+    if (!file.is_open()) return;
+    WriteEvent(ReplayEvent::END, finalTick);
+    file.close();
+}
+
+void ReplayWriter::RecordInput(uint64_t tick, const TickInput& input) {
+    uint8_t mask = InputToMask(input);
+    if (!file.is_open() || mask == lastInputMask) return;
+    
+    WriteEvent(ReplayEvent::INPUT, tick);
+    file.put((char)mask);
+    lastInputMask = mask;
+}
+
+void ReplayWriter::RecordCommand(uint64_t tick, const std::string& command) {
+    if (!file.is_open()) return;
+    WriteEvent(ReplayEvent::COMMAND, tick);
+    WriteString(command);
+    // Commands are rare and are what bug reports hinge on, so don't leave them buffered
+    file.flush();
+}
+
+void ReplayWriter::RecordTeleport(uint64_t tick, const std::string& roomName) {
+    if (!file.is_open()) return;
+    WriteEvent(ReplayEvent::TELEPORT, tick);
+    WriteString(roomName);
+    file.flush();
+}
+
+void ReplayWriter::WriteEvent(ReplayEvent type, uint64_t tick) {
+    // Players reject longer gaps as corrupt, so a long idle stretch is bridged with
+    // repeats of the current input, which change nothing when replayed
+    while (tick - lastTick > (uint64_t)Simulation::MAX_WAIT_TICKS) {
+        file.put((char)ReplayEvent::INPUT);
+        WriteVarint((uint64_t)Simulation::MAX_WAIT_TICKS);
+        file.put((char)lastInputMask);
+        lastTick += Simulation::MAX_WAIT_TICKS;
+    }
+    file.put((char)type);
+    WriteVarint(tick - lastTick);
+    lastTick = tick;
+}
+
+void ReplayWriter::WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+        file.put((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    file.put((char)value);
+}
+
+void ReplayWriter::WriteString(const std::string& text) {
+    WriteVarint(text.size());
+    file.write(text.data(), text.size());
+}
+
+ReplayPlayer::ReplayPlayer() : seed(0), depthRooms(0), fileSize(0) {}
+
+bool ReplayPlayer::Open(const std::string& path) {
+    file.open(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    fileSize = (uint64_t)file.tellg();
+    file.seekg(0);
+    
+    char magic[4];
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, REPLAY_MAGIC)) {
+        return false;
+    }
+    int version = file.get();
+    if (version != REPLAY_VERSION) {
+        return false;
+    }
+    
+    seed = 0;
+    for (int i = 0; i < 8; i++) {
+        int byte = file.get();
+        if (byte == EOF) return false;
+        seed |= (uint64_t)(uint8_t)byte << (i * 8);
+    }
+    
+    uint64_t count = 0;
+    if (!ReadVarint(count) || count > (uint64_t)Simulation::MAX_DEPTH_ROOMS) {
+        return false;
+    }
+    depthRooms = (int)count;
+    return true;
+}
+
+bool ReplayPlayer::Play(Simulation& simulation) {
+    simulation.SetReplaying(true);
+    bool valid = PlayEvents(simulation);
+    simulation.SetReplaying(false);
+    return valid;
+}
+
+bool ReplayPlayer::PlayEvents(Simulation& simulation) {
+    TickInput input;
+    uint64_t eventTick = simulation.GetState().tick;
+    
+    int type;
+    while ((type = file.get()) != EOF) {
+        uint64_t delta;
+        if (!ReadVarint(delta)) break;
+        
+        // A writer never leaves a bigger gap, so anything larger is damage, and would
+        // otherwise have the loop below tick for as long as it claims
+        if (delta > (uint64_t)Simulation::MAX_WAIT_TICKS) return false;
+        eventTick += delta;
+        
+        // Everything recorded for a tick happened before that tick ran. The input is
+        // replayed exactly as recorded, presses included, since it was logged per tick
+        while (simulation.GetState().tick < eventTick && !simulation.GetState().shouldQuit) {
+            simulation.Tick(input);
+        }
+        
+        std::string text;
+        switch ((ReplayEvent)type) {
+            case ReplayEvent::INPUT: {
+                int mask = file.get();
+                if (mask == EOF) return true;
+                input = MaskToInput((uint8_t)mask);
+                break;
+            }
+            case ReplayEvent::COMMAND:
+                if (!ReadString(text)) return true;
+                simulation.SubmitCommand(text);
+                break;
+            case ReplayEvent::TELEPORT:
+                if (!ReadString(text)) return true;
+                simulation.TeleportToRoom(text);
+                break;
+            case ReplayEvent::END:
+                return true;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool ReplayPlayer::ReadVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = file.get();
+        if (byte == EOF) return false;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+bool ReplayPlayer::ReadString(std::string& text) {
+    uint64_t length;
+    if (!ReadVarint(length)) return false;
+    
+    // A corrupt length would otherwise allocate whatever it claims before the read fails
+    std::streamoff position = file.tellg();
+    if (position < 0 || length > fileSize - (uint64_t)position) return false;
+    text.resize(length);
+    return length == 0 || (bool)file.read(&text[0], length);
+}
\ No newline at end of file
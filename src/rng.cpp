@@ -0,0 +1,43 @@
+#include "rng.h"
+
+Rng::Rng(uint64_t seed) {
+    Seed(seed);
+}
+
+void Rng::Seed(uint64_t newSeed) {
+    seed = newSeed;
+    
+    // Expand the seed with splitmix64 so that nearby seeds give unrelated streams
+    uint64_t x = newSeed;
+    for (int i = 0; i < 4; i += 2) {
+        x += 0x9E3779B97F4A7C15ull;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        s[i] = (uint32_t)z;
+        s[i + 1] = (uint32_t)(z >> 32);
+    }
+}
+
+void Rng::GetState(uint32_t out[4]) const {
+    for (int i = 0; i < 4; i++) {
+        out[i] = s[i];
+    }
+}
+
+void Rng::SetState(uint64_t newSeed, const uint32_t in[4]) {
+    seed = newSeed;
+    for (int i = 0; i < 4; i++) {
+        s[i] = in[i];
+    }
+}
+
+int Rng::HashInt(uint64_t a, uint64_t b, int bound) const {
+    // splitmix64 finalizer over the combined key
+    uint64_t z = seed + a * 0x9E3779B97F4A7C15ull + b * 0xD1B54A32D192ED03ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (int)(((z >> 32) * (uint32_t)bound) >> 32);
+}
\ No newline at end of file
@@ -1,10 +1,15 @@
 #include "room.h"
+#include "monster_store.h"
+#include <algorithm>
 
 Room::Room(const std::string& name, const std::string& description) 
-    : name(name), description(description), visited(false) {}
+    : name(name), id(-1), description(description), visited(false), revision(0) {
+    BuildWalkMask();
+}
 
 void Room::SetExit(const std::string& direction, Room* room) {
     exits[direction] = room;
+    revision++;
 }
 
 Room* Room::GetExit(const std::string& direction) {
@@ -15,42 +20,79 @@ Room* Room::GetExit(const std::string& direction) {
     return nullptr;
 }
 
+void Room::BuildWalkMask() {
+    const int width = RoomTheme::GRID_WIDTH;
+    const int height = RoomTheme::GRID_HEIGHT;
+    
+    // Everything inside the border walls starts out walkable
+    uint32_t interior = ((1u << (width - 2)) - 1u) << 1;
+    for (int y = 0; y < height; y++) {
+        walkableRows[y] = (y == 0 || y == height - 1) ? 0u : interior;
+    }
+    
+    for (const auto& obstacle : theme.GetObstacles()) {
+        for (int y = obstacle.tileY; y < obstacle.tileY + obstacle.tilesHigh; y++) {
+            for (int x = obstacle.tileX; x < obstacle.tileX + obstacle.tilesWide; x++) {
+                if (x >= 0 && x < width && y >= 0 && y < height) {
+                    walkableRows[y] &= ~(1u << x);
+                }
+            }
+        }
+    }
+}
+
 void Room::AddItem(const Item& item) {
     items.push_back(item);
+    revision++;
 }
 
 void Room::AddMonster(const Monster& monster) {
-    monsters.push_back(monster);
+    spawns.push_back(monster);
 }
 
-bool Room::RemoveItem(const std::string& itemName) {
+std::vector<Monster> Room::TakeSpawns() {
+    std::vector<Monster> taken;
+    taken.swap(spawns);
+    return taken;
+}
+
+bool Room::RemoveItem(Name itemName) {
     for (auto it = items.begin(); it != items.end(); ++it) {
         if (it->name == itemName && it->takeable) {
             items.erase(it);
+            revision++;
             return true;
         }
     }
     return false;
 }
 
+void Room::ClearContents() {
+    exits.clear();
+    items.clear();
+    spawns.clear();
+    revision++;
+}
 
-std::string Room::GetDescription() const {
+std::string Room::GetDescription(const MonsterStore& monsters) const {
     std::string fullDesc = description;
     
     if (!items.empty()) {
         fullDesc += "\n\nYou see: ";
         for (size_t i = 0; i < items.size(); ++i) {
             if (i > 0) fullDesc += ", ";
-            fullDesc += items[i].name;
+            fullDesc += items[i].name.GetText();
         }
     }
     
-    if (!monsters.empty()) {
+    size_t first = monsters.RoomBegin(id);
+    size_t last = monsters.RoomEnd(id);
+    if (first != last) {
         fullDesc += "\n\nCreatures: ";
-        for (size_t i = 0; i < monsters.size(); ++i) {
-            if (monsters[i].alive) {
-                if (i > 0) fullDesc += ", ";
-                fullDesc += monsters[i].name;
+        for (size_t i = first; i < last; ++i) {
+            if (monsters.alive[i]) {
+                if (i > first) fullDesc += ", ";
+                fullDesc += monsters.name[i].GetText();
             }
         }
     }
@@ -64,4 +106,14 @@ std::vector<std::string> Room::GetExits() const {
         exitList.push_back(exit.first);
     }
     return exitList;
+}
+
+std::vector<Room*> Room::GetAdjacentRooms() const {
+    std::vector<Room*> adjacent;
+    for (const auto& exit : exits) {
+        if (exit.second && std::find(adjacent.begin(), adjacent.end(), exit.second) == adjacent.end()) {
+            adjacent.push_back(exit.second);
+        }
+    }
+    return adjacent;
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "room_factory.h"
+#include "dungeon_generator.h"
 
-std::vector<std::unique_ptr<Room>> RoomFactory::CreateAllRooms() {
+static const int TILE_SIZE = RoomTheme::TILE_SIZE;
+
+std::vector<std::unique_ptr<Room>> RoomFactory::CreateAllRooms(Rng& rng, int depthRooms) {
     std::vector<std::unique_ptr<Room>> rooms;
     
     rooms.push_back(CreateEntranceHall());      // Index 0
@@ -8,17 +11,27 @@ std::vector<std::unique_ptr<Room>> RoomFactory::CreateAllRooms() {
     rooms.push_back(CreateTreasureChamber());   // Index 2
     rooms.push_back(CreateDarkCorridor());      // Index 3
     rooms.push_back(CreateMonsterLair());       // Index 4
-    rooms.push_back(CreateLibrary());           // Index 5
+    rooms.push_back(CreateLibrary(rng));        // Index 5
     rooms.push_back(CreateKitchen());           // Index 6
     rooms.push_back(CreateBasement());          // Index 7
     rooms.push_back(CreateThroneRoom());        // Index 8
-    rooms.push_back(CreateGarden());            // Index 9
+    rooms.push_back(CreateGarden(rng));         // Index 9
     rooms.push_back(CreateInfirmary());         // Index 10
     rooms.push_back(CreateSunlitMeadow());      // Index 11
     rooms.push_back(CreateDarkRoom());          // Index 12
     rooms.push_back(CreateChapel());            // Index 13
     rooms.push_back(CreateSleepingQuarters());  // Index 14
     
+    // Collision is derived from each theme's obstacles once, up front
+    for (auto& room : rooms) {
+        room->BuildWalkMask();
+    }
+    
+    // The Depths come already built and joined among themselves; ConnectRooms attaches them
+    for (auto& room : DungeonGenerator::Generate(rng.GetSeed(), depthRooms)) {
+        rooms.push_back(std::move(room));
+    }
+    
     return rooms;
 }
 
@@ -69,6 +82,12 @@ void RoomFactory::ConnectRooms(std::vector<std::unique_ptr<Room>>& rooms) {
     // Dark Room connections
     rooms[12]->SetExit("up", rooms[9].get());      // to garden
     
+    // Stairs from the basement down into the generated Depths, if there are any
+    if ((int)rooms.size() > STORY_ROOM_COUNT) {
+        rooms[7]->SetExit("down", rooms[STORY_ROOM_COUNT].get());
+        rooms[STORY_ROOM_COUNT]->SetExit("up", rooms[7].get());
+    }
+    
     // Note: Chapel and Sleeping Quarters connections are added dynamically after note is read:
     // - Sunlit Meadow (11) <-> Chapel (13) via east/west
     // - Throne Room (8) <-> Sleeping Quarters (14) via north/south
@@ -77,6 +96,40 @@ void RoomFactory::ConnectRooms(std::vector<std::unique_ptr<Room>>& rooms) {
 std::unique_ptr<Room> RoomFactory::CreateEntranceHall() {
     auto room = std::make_unique<Room>("Entrance Hall", 
         "You stand in a dimly lit stone hall. Ancient torches flicker on the walls, casting dancing shadows. The air smells of dust and age.");
+    
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({96, 80, 64, 255});
+    
+    // Stone pillars with bright torches
+    for (int i = 0; i < 3; i++) {
+        int pillarX = (3 + i * 6) * TILE_SIZE;
+        int pillarY = 3 * TILE_SIZE;
+        theme.AddObstacle(3 + i * 6, 3, 1, 3, {120, 100, 85, 255});
+        theme.AddOutline(pillarX, pillarY, TILE_SIZE, TILE_SIZE * 3, {80, 60, 45, 255});
+        theme.AddRect(pillarX + 4, pillarY - 8, TILE_SIZE - 8, 16, {255, 180, 0, 255}); // Flame
+        theme.AddOutline(pillarX + 4, pillarY - 8, TILE_SIZE - 8, 16, {255, 100, 0, 255});
+    }
+    
+    // Central altar
+    int altarX = 9 * TILE_SIZE;
+    int altarY = 8 * TILE_SIZE;
+    theme.AddRect(altarX, altarY, TILE_SIZE * 3, TILE_SIZE * 2, {140, 120, 100, 255});
+    theme.AddOutline(altarX, altarY, TILE_SIZE * 3, TILE_SIZE * 2, {100, 80, 60, 255});
+    
+    // Decorative floor patterns
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            theme.AddRect((2 + i * 5) * TILE_SIZE + 8, (12 + j * 2) * TILE_SIZE + 8, 16, 16, {160, 140, 120, 255});
+        }
+    }
+    
+    // Wall banners
+    int rightBannerX = (RoomTheme::GRID_WIDTH - 2) * TILE_SIZE - 24;
+    theme.AddRect(TILE_SIZE + 8, 2 * TILE_SIZE, 16, 48, {150, 0, 0, 255});
+    theme.AddRect(rightBannerX, 2 * TILE_SIZE, 16, 48, {150, 0, 0, 255});
+    theme.AddOutline(TILE_SIZE + 8, 2 * TILE_SIZE, 16, 48, {100, 0, 0, 255});
+    theme.AddOutline(rightBannerX, 2 * TILE_SIZE, 16, 48, {100, 0, 0, 255});
+    
     return room;
 }
 
@@ -84,6 +137,52 @@ std::unique_ptr<Room> RoomFactory::CreateArmory() {
     auto room = std::make_unique<Room>("Armory", 
         "This room once held weapons and armor. Rusted sword racks line the walls, and broken shields litter the floor.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({80, 80, 96, 255});
+    
+    // Weapon racks with swords
+    for (int i = 0; i < 4; i++) {
+        int rackX = (2 + i * 4) * TILE_SIZE;
+        int rackY = 2 * TILE_SIZE;
+        theme.AddObstacle(2 + i * 4, 2, 1, 3, {120, 80, 40, 255});
+        theme.AddOutline(rackX, rackY, TILE_SIZE, TILE_SIZE * 3, {80, 50, 25, 255});
+        
+        for (int j = 0; j < 3; j++) {
+            int swordX = rackX + 4;
+            int swordY = rackY + 8 + j * 20;
+            theme.AddRect(swordX, swordY, 6, 20, {230, 230, 230, 255}); // Blade
+            theme.AddOutline(swordX, swordY, 6, 20, {180, 180, 180, 255});
+            theme.AddRect(swordX - 1, swordY + 20, 8, 6, {160, 100, 50, 255}); // Hilt
+            theme.AddRect(swordX - 2, swordY + 18, 10, 2, {140, 140, 140, 255}); // Crossguard
+        }
+    }
+    
+    // Shield display on back wall
+    for (int i = 0; i < 3; i++) {
+        int shieldX = (6 + i * 4) * TILE_SIZE;
+        int shieldY = TILE_SIZE;
+        theme.AddRect(shieldX, shieldY, 24, 24, {190, 190, 190, 255});
+        theme.AddOutline(shieldX, shieldY, 24, 24, {120, 120, 120, 255});
+        theme.AddRect(shieldX + 8, shieldY + 8, 8, 8, {255, 215, 0, 255}); // Shield boss
+        theme.AddOutline(shieldX + 8, shieldY + 8, 8, 8, {200, 170, 0, 255});
+    }
+    
+    // Armor stands
+    for (int i = 0; i < 2; i++) {
+        int armorX = (5 + i * 8) * TILE_SIZE;
+        int armorY = 8 * TILE_SIZE;
+        theme.AddRect(armorX, armorY, 24, 32, {160, 160, 160, 255});
+        theme.AddOutline(armorX, armorY, 24, 32, {100, 100, 100, 255});
+        theme.AddRect(armorX + 4, armorY - 12, 16, 12, {150, 150, 150, 255}); // Helmet
+        theme.AddOutline(armorX + 4, armorY - 12, 16, 12, {90, 90, 90, 255});
+    }
+    
+    // Scattered weapons on floor
+    theme.AddRect(12 * TILE_SIZE, 12 * TILE_SIZE, 20, 4, {230, 230, 230, 255}); // Sword
+    theme.AddOutline(12 * TILE_SIZE, 12 * TILE_SIZE, 20, 4, {180, 180, 180, 255});
+    theme.AddRect(6 * TILE_SIZE, 13 * TILE_SIZE, 4, 16, {160, 100, 50, 255}); // Axe
+    theme.AddRect(6 * TILE_SIZE - 4, 13 * TILE_SIZE, 12, 4, {150, 150, 150, 255});
+    
     room->AddItem(Item("sword", "A sharp steel sword with a leather-wrapped hilt.", true, ItemType::WEAPON, 5, 0));
     room->AddItem(Item("shield", "A sturdy wooden shield reinforced with metal bands.", true, ItemType::ARMOR, 0, 3));
     
@@ -94,6 +193,60 @@ std::unique_ptr<Room> RoomFactory::CreateTreasureChamber() {
     auto room = std::make_unique<Room>("Treasure Chamber", 
         "Gold coins and precious gems are scattered across the floor. A massive chest sits in the center, slightly ajar.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({128, 112, 48, 255});
+    
+    // Treasure chest in center
+    int chestX = 8 * TILE_SIZE;
+    int chestY = 6 * TILE_SIZE;
+    theme.AddObstacle(8, 6, 3, 2, {130, 65, 20, 255});
+    theme.AddOutline(chestX, chestY, TILE_SIZE * 3, TILE_SIZE * 2, {90, 45, 15, 255});
+    theme.AddRect(chestX + 16, chestY + 8, 12, 12, {255, 215, 0, 255}); // Lock
+    theme.AddOutline(chestX + 16, chestY + 8, 12, 12, {200, 170, 0, 255});
+    theme.AddRect(chestX, chestY, 12, 6, {80, 80, 80, 255}); // Hinges
+    theme.AddRect(chestX + 36, chestY, 12, 6, {80, 80, 80, 255});
+    
+    // Gold coin piles
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 6; j++) {
+            int coinX = (2 * TILE_SIZE) + (i * 16) + (j % 2 * 8);
+            int coinY = (3 * TILE_SIZE) + (j * 12) + (i % 2 * 6);
+            if (coinX < 21 * TILE_SIZE && coinY < 15 * TILE_SIZE) {
+                theme.AddRect(coinX, coinY, 6, 6, {255, 215, 0, 255});
+                theme.AddOutline(coinX, coinY, 6, 6, {200, 170, 0, 255});
+            }
+        }
+    }
+    
+    // Gem piles
+    for (int i = 0; i < 4; i++) {
+        int gemX = (4 + i * 4) * TILE_SIZE;
+        int gemY = (10 + (i % 2) * 2) * TILE_SIZE;
+        theme.AddRect(gemX, gemY, 12, 12, {255, 0, 255, 255}); // purple gems
+        theme.AddOutline(gemX, gemY, 12, 12, {200, 0, 200, 255});
+        theme.AddRect(gemX + 16, gemY, 12, 12, {0, 255, 0, 255}); // green gems
+        theme.AddOutline(gemX + 16, gemY, 12, 12, {0, 200, 0, 255});
+        theme.AddRect(gemX + 32, gemY, 12, 12, {255, 0, 0, 255}); // red gems
+        theme.AddOutline(gemX + 32, gemY, 12, 12, {200, 0, 0, 255});
+    }
+    
+    // Golden candlesticks
+    for (int i = 0; i < 4; i++) {
+        int candleX = (2 + i * 4) * TILE_SIZE;
+        int candleY = 2 * TILE_SIZE;
+        theme.AddRect(candleX, candleY, 12, 32, {255, 215, 0, 255});
+        theme.AddOutline(candleX, candleY, 12, 32, {200, 170, 0, 255});
+        theme.AddRect(candleX + 2, candleY - 8, 8, 8, {255, 150, 0, 255}); // Flame
+    }
+    
+    // Ornate golden pillars
+    for (int i = 0; i < 2; i++) {
+        int pillarX = (3 + i * 12) * TILE_SIZE;
+        int pillarY = TILE_SIZE;
+        theme.AddRect(pillarX, pillarY, 16, TILE_SIZE * 5, {255, 215, 0, 255});
+        theme.AddOutline(pillarX, pillarY, 16, TILE_SIZE * 5, {200, 170, 0, 255});
+    }
+    
     room->AddItem(Item("gold", "A handful of gleaming gold coins.", true, ItemType::MISC, 0, 0));
     room->AddItem(Item("gem", "A sparkling ruby that seems to pulse with inner light.", true, ItemType::MISC, 0, 0));
     
@@ -104,6 +257,35 @@ std::unique_ptr<Room> RoomFactory::CreateDarkCorridor() {
     auto room = std::make_unique<Room>("Dark Corridor", 
         "A narrow, winding passage stretches before you. The walls are damp and covered in strange moss that glows faintly.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({32, 32, 48, 255});
+    
+    // Moss on walls
+    for (int i = 0; i < RoomTheme::GRID_HEIGHT - 2; i++) {
+        int mossY = (1 + i) * TILE_SIZE + 8;
+        int mossXs[] = {2 * TILE_SIZE, (RoomTheme::GRID_WIDTH - 3) * TILE_SIZE};
+        for (int mossX : mossXs) {
+            theme.AddRect(mossX, mossY, 8, 16, {0, 96, 48, 255});
+            theme.AddRect(mossX + 8, mossY, 8, 16, {0, 64, 32, 255});
+        }
+    }
+    
+    // Puddles of water
+    for (int i = 0; i < 4; i++) {
+        int puddleX = (4 + i * 4) * TILE_SIZE;
+        int puddleY = (8 + i % 2 * 3) * TILE_SIZE;
+        theme.AddRect(puddleX, puddleY, 24, 16, {0, 0, 64, 180}); // Dark water
+        theme.AddRect(puddleX + 4, puddleY + 4, 16, 8, {0, 0, 96, 120}); // Reflection
+    }
+    
+    // Dim torches
+    for (int i = 0; i < 3; i++) {
+        int torchX = (6 + i * 4) * TILE_SIZE;
+        int torchY = 2 * TILE_SIZE;
+        theme.AddRect(torchX, torchY, 8, 24, {64, 32, 16, 255}); // Torch handle
+        theme.AddRect(torchX + 2, torchY - 8, 4, 8, {128, 64, 0, 255}); // Dim flame
+    }
+    
     room->AddMonster(Monster("skeleton", "A rattling skeleton wielding a rusty sword.", 20, 8, 15.0f, 8.0f));
     
     return room;
@@ -113,15 +295,92 @@ std::unique_ptr<Room> RoomFactory::CreateMonsterLair() {
     auto room = std::make_unique<Room>("Monster Lair", 
         "Bones and debris cover the floor of this foul-smelling chamber. Claw marks scar the stone walls.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({64, 48, 48, 255});
+    
+    // Scattered bones and skulls
+    for (int i = 0; i < 8; i++) {
+        int boneX = (2 + (i * 2) % 16) * TILE_SIZE + (i % 8);
+        int boneY = (2 + (i / 2) % 11) * TILE_SIZE + ((i * 3) % 8);
+        theme.AddRect(boneX, boneY, 20, 8, {240, 240, 220, 255});
+        theme.AddRect(boneX + 6, boneY - 8, 8, 16, {240, 240, 220, 255});
+        
+        if (i % 3 == 0) {
+            theme.AddRect(boneX + 16, boneY - 4, 12, 10, {240, 240, 220, 255});
+            theme.AddRect(boneX + 18, boneY - 2, 2, 2, {0, 0, 0, 255}); // eye socket
+            theme.AddRect(boneX + 24, boneY - 2, 2, 2, {0, 0, 0, 255}); // eye socket
+        }
+    }
+    
+    // Claw marks on walls
+    for (int i = 0; i < 6; i++) {
+        int clawX = (1 + i * 3) * TILE_SIZE;
+        int clawY = (1 + i % 2) * TILE_SIZE;
+        theme.AddRect(clawX, clawY, 4, 16, {64, 32, 32, 255});
+        theme.AddRect(clawX + 8, clawY, 4, 16, {64, 32, 32, 255});
+        theme.AddRect(clawX + 16, clawY, 4, 16, {64, 32, 32, 255});
+    }
+    
     room->AddMonster(Monster("goblin", "A small, green-skinned creature with sharp teeth and claws.", 15, 5, 8.0f, 10.0f));
     
     return room;
 }
 
-std::unique_ptr<Room> RoomFactory::CreateLibrary() {
+std::unique_ptr<Room> RoomFactory::CreateLibrary(Rng& rng) {
     auto room = std::make_unique<Room>("Library", 
         "Ancient books and scrolls fill wooden shelves that reach to the ceiling. Dust particles dance in shafts of light from somewhere above.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({80, 64, 48, 255});
+    
+    // Tall bookshelves along walls
+    for (int wall = 0; wall < 2; wall++) {
+        for (int i = 0; i < 4; i++) {
+            int shelfX = (2 + wall * 14) * TILE_SIZE;
+            int shelfY = (1 + i * 3) * TILE_SIZE;
+            theme.AddObstacle(2 + wall * 14, 1 + i * 3, 3, 2, {112, 56, 16, 255});
+            
+            for (int j = 0; j < 12; j++) {
+                PixelColor bookColor = (j % 4 == 0) ? PixelColor{200, 50, 50, 255} :
+                                       (j % 4 == 1) ? PixelColor{50, 200, 50, 255} :
+                                       (j % 4 == 2) ? PixelColor{50, 50, 200, 255} :
+                                                      PixelColor{200, 200, 50, 255};
+                theme.AddRect(shelfX + 4 + j * 2, shelfY + 8, 4, 12, bookColor);
+            }
+        }
+    }
+    
+    // Reading table in center
+    int tableX = 7 * TILE_SIZE;
+    int tableY = 6 * TILE_SIZE;
+    theme.AddRect(tableX, tableY, TILE_SIZE * 4, TILE_SIZE * 2, {139, 69, 19, 255});
+    theme.AddRect(tableX + 8, tableY + 4, 16, 12, {255, 248, 220, 255}); // open book
+    theme.AddRect(tableX + 24, tableY + 8, 12, 8, {200, 50, 50, 255}); // closed book
+    
+    // Candles for reading
+    for (int i = 0; i < 3; i++) {
+        int candleX = tableX + 4 + i * 16;
+        int candleY = tableY - 8;
+        theme.AddRect(candleX, candleY, 4, 12, {255, 248, 220, 255});
+        theme.AddRect(candleX + 1, candleY - 4, 2, 4, {255, 100, 0, 255}); // flame
+    }
+    
+    // Scattered scrolls on floor
+    for (int i = 0; i < 5; i++) {
+        int scrollX = (3 + i * 3) * TILE_SIZE + rng.NextInt(8);
+        int scrollY = (10 + i % 2) * TILE_SIZE + rng.NextInt(8);
+        theme.AddRect(scrollX, scrollY, 16, 4, {255, 248, 220, 255});
+    }
+    
+    // Ladder to reach high shelves
+    int ladderX = 16 * TILE_SIZE;
+    int ladderY = 2 * TILE_SIZE;
+    theme.AddRect(ladderX, ladderY, 4, TILE_SIZE * 4, {139, 69, 19, 255});
+    theme.AddRect(ladderX + 12, ladderY, 4, TILE_SIZE * 4, {139, 69, 19, 255});
+    for (int py = 0; py < TILE_SIZE * 4; py += 16) {
+        theme.AddRect(ladderX, ladderY + py + 4, 16, 4, {139, 69, 19, 255}); // rungs
+    }
+    
     room->AddItem(Item("book", "An ancient tome of forgotten lore.", true, ItemType::MISC, 0, 0));
     room->AddItem(Item("scroll", "A mysterious scroll with strange symbols.", true, ItemType::MISC, 0, 0));
     
@@ -132,6 +391,40 @@ std::unique_ptr<Room> RoomFactory::CreateKitchen() {
     auto room = std::make_unique<Room>("Kitchen", 
         "A medieval kitchen with stone ovens and wooden tables. Cast iron pots and cooking utensils hang from hooks on the walls.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({80, 64, 48, 255});
+    
+    // Large wooden table
+    int tableX = 6 * TILE_SIZE;
+    int tableY = 5 * TILE_SIZE;
+    theme.AddObstacle(6, 5, 3, 2, {128, 96, 64, 255});
+    theme.AddRect(tableX + 8, tableY + 4, 16, 4, {192, 192, 192, 255}); // knife
+    theme.AddRect(tableX + 32, tableY + 8, 12, 8, {160, 82, 45, 255}); // pot
+    theme.AddRect(tableX + 48, tableY + 6, 8, 6, {255, 215, 0, 255}); // gold items
+    
+    // Cooking pots and utensils
+    for (int i = 0; i < 3; i++) {
+        int potX = (3 + i * 2) * TILE_SIZE;
+        int potY = 3 * TILE_SIZE;
+        theme.AddObstacle(3 + i * 2, 3, 1, 1, {64, 64, 64, 255});
+        theme.AddRect(potX - 4, potY + 8, 8, 4, {48, 48, 48, 255}); // Pot handles
+        theme.AddRect(potX + TILE_SIZE, potY + 8, 8, 4, {48, 48, 48, 255});
+        
+        // Steam/smoke
+        if (i == 1) {
+            for (int s = 0; s < 3; s++) {
+                theme.AddRect(potX + 8 + s * 4, potY - 8 - s * 4, 4, 4, {200, 200, 200, 100});
+            }
+        }
+    }
+    
+    // Stone oven
+    int ovenX = 2 * TILE_SIZE;
+    int ovenY = 8 * TILE_SIZE;
+    theme.AddRect(ovenX, ovenY, TILE_SIZE * 2, TILE_SIZE * 2, {80, 80, 60, 255});
+    theme.AddRect(ovenX + 8, ovenY + 16, 16, 8, {32, 16, 16, 255}); // Oven opening
+    theme.AddRect(ovenX + 12, ovenY + 12, 8, 4, {255, 100, 0, 255}); // fire
+    
     room->AddItem(Item("pot", "A cast iron cooking pot.", true, ItemType::MISC, 0, 0));
     room->AddItem(Item("knife", "A sharp kitchen knife with a wooden handle.", true, ItemType::WEAPON, 2, 0));
     
@@ -142,6 +435,43 @@ std::unique_ptr<Room> RoomFactory::CreateBasement() {
     auto room = std::make_unique<Room>("Basement", 
         "A damp underground storage room filled with wooden barrels and crates. The smell of aged wine and preserved foods fills the air.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({32, 32, 32, 255});
+    
+    // Wine barrels with metal bands
+    for (int i = 0; i < 6; i++) {
+        int barrelX = (2 + i * 3) * TILE_SIZE;
+        int barrelY = (2 + (i % 2) * 5) * TILE_SIZE;
+        theme.AddObstacle(2 + i * 3, 2 + (i % 2) * 5, 1, 2, {96, 64, 32, 255});
+        theme.AddRect(barrelX, barrelY + 8, TILE_SIZE, 4, {64, 64, 64, 255});
+        theme.AddRect(barrelX, barrelY + 32, TILE_SIZE, 4, {64, 64, 64, 255});
+        
+        // Spigot/tap
+        if (i % 2 == 0) {
+            theme.AddRect(barrelX + TILE_SIZE, barrelY + 16, 8, 4, {128, 128, 128, 255});
+            theme.AddRect(barrelX + TILE_SIZE + 8, barrelY + 18, 4, 2, {64, 64, 64, 255});
+        }
+    }
+    
+    // Wooden crates
+    for (int i = 0; i < 4; i++) {
+        int crateX = (15 + (i % 2) * 3) * TILE_SIZE;
+        int crateY = (3 + (i / 2) * 4) * TILE_SIZE;
+        theme.AddRect(crateX, crateY, TILE_SIZE * 2, TILE_SIZE, {112, 80, 48, 255});
+        theme.AddRect(crateX + 8, crateY, 4, TILE_SIZE, {80, 56, 32, 255}); // Slats
+        theme.AddRect(crateX + 24, crateY, 4, TILE_SIZE, {80, 56, 32, 255});
+    }
+    
+    // Wine bottles on shelves
+    int shelfX = 17 * TILE_SIZE;
+    int shelfY = TILE_SIZE;
+    theme.AddRect(shelfX, shelfY, TILE_SIZE * 3, 8, {112, 80, 48, 255});
+    for (int i = 0; i < 8; i++) {
+        int bottleX = shelfX + 4 + i * 6;
+        theme.AddRect(bottleX, shelfY - 16, 4, 16, {0, 64, 0, 255}); // green bottles
+        theme.AddRect(bottleX, shelfY - 20, 4, 4, {64, 32, 16, 255}); // cork
+    }
+    
     room->AddItem(Item("wine", "A bottle of aged wine.", true, ItemType::MISC, 0, 0));
     room->AddItem(Item("key", "A rusty old key.", true, ItemType::MISC, 0, 0));
     room->AddMonster(Monster("rat", "A large, mangy rat with glowing red eyes.", 8, 3, 6.0f, 12.0f));
@@ -153,16 +483,57 @@ std::unique_ptr<Room> RoomFactory::CreateThroneRoom() {
     auto room = std::make_unique<Room>("Throne Room", 
         "A grand chamber with a massive stone throne decorated with purple cushions. Tapestries depicting ancient battles hang on the walls.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({64, 48, 80, 255});
+    
+    int throneX = 8 * TILE_SIZE;
+    int throneY = 3 * TILE_SIZE;
+    theme.AddObstacle(8, 3, 3, 4, {96, 64, 128, 255});
+    theme.AddRect(throneX + 8, throneY + 8, TILE_SIZE * 3 - 16, TILE_SIZE * 2 - 8, {144, 112, 160, 255}); // Cushion
+    
     room->AddItem(Item("crown", "A golden crown encrusted with jewels.", true, ItemType::ARMOR, 0, 2));
     room->AddMonster(Monster("ghost", "A translucent figure in royal robes, floating above the throne.", 50, 12, 18.0f, 6.0f));
     
     return room;
 }
 
-std::unique_ptr<Room> RoomFactory::CreateGarden() {
+std::unique_ptr<Room> RoomFactory::CreateGarden(Rng& rng) {
     auto room = std::make_unique<Room>("Garden", 
         "A small indoor garden with colorful flowers and herbs growing in neat rows. Sunlight streams through a glass ceiling above.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({48, 80, 32, 255});
+    
+    // Flower beds
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 4; j++) {
+            int flowerX = (3 + i * 2) * TILE_SIZE + rng.NextInt(16);
+            int flowerY = (3 + j * 2) * TILE_SIZE + rng.NextInt(16);
+            PixelColor flowerColor = (rng.NextInt(3) == 0) ? PixelColor{255, 64, 64, 255} :
+                                     (rng.NextInt(3) == 1) ? PixelColor{64, 64, 255, 255} :
+                                                        PixelColor{255, 255, 64, 255};
+            theme.AddRect(flowerX, flowerY, 8, 8, flowerColor);
+            theme.AddRect(flowerX, flowerY + 8, 8, 8, {0, 128, 0, 255});
+        }
+    }
+    
+    // Wooden trapdoor in the center-bottom of the garden
+    int trapdoorX = 10 * TILE_SIZE;
+    int trapdoorY = 12 * TILE_SIZE;
+    theme.AddRect(trapdoorX, trapdoorY, TILE_SIZE * 3, TILE_SIZE * 2, {101, 67, 33, 255});
+    theme.AddOutline(trapdoorX, trapdoorY, TILE_SIZE * 3, TILE_SIZE * 2, {80, 50, 25, 255});
+    theme.AddRect(trapdoorX + 4, trapdoorY + 4, 8, 12, {120, 120, 120, 255}); // Hinges
+    theme.AddRect(trapdoorX + TILE_SIZE * 3 - 12, trapdoorY + 4, 8, 12, {120, 120, 120, 255});
+    theme.AddRect(trapdoorX + TILE_SIZE + 8, trapdoorY + TILE_SIZE - 4, 16, 8, {120, 120, 120, 255}); // Ring handle
+    theme.AddOutline(trapdoorX + TILE_SIZE + 8, trapdoorY + TILE_SIZE - 4, 16, 8, {80, 80, 80, 255});
+    for (int i = 0; i < 3; i++) {
+        theme.AddRect(trapdoorX + 8 + i * 24, trapdoorY + 8, 2, TILE_SIZE * 2 - 16, {80, 50, 25, 255}); // Wood grain
+    }
+    
+    // Slightly ajar opening showing darkness below
+    theme.AddRect(trapdoorX + TILE_SIZE * 2, trapdoorY + TILE_SIZE, TILE_SIZE - 8, 12, {20, 20, 20, 255});
+    theme.AddOutline(trapdoorX + TILE_SIZE * 2, trapdoorY + TILE_SIZE, TILE_SIZE - 8, 12, {40, 40, 40, 255});
+    
     room->AddItem(Item("herbs", "A bundle of healing herbs.", true, ItemType::MISC, 0, 0));
     room->AddItem(Item("seeds", "A pouch of rare flower seeds.", true, ItemType::MISC, 0, 0));
     
@@ -173,6 +544,57 @@ std::unique_ptr<Room> RoomFactory::CreateInfirmary() {
     auto room = std::make_unique<Room>("Infirmary", 
         "A small medical room with stone shelves lined with bottles and bandages. A wooden cot sits in the corner, and healing herbs hang from the ceiling.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({96, 96, 112, 255}); // Light blue-gray for medical room
+    
+    // Medical shelves on left and right walls
+    for (int i = 0; i < 3; i++) {
+        int leftShelfX = 2 * TILE_SIZE;
+        int rightShelfX = (RoomTheme::GRID_WIDTH - 4) * TILE_SIZE;
+        int shelfY = (2 + i * 4) * TILE_SIZE;
+        theme.AddRect(leftShelfX, shelfY, TILE_SIZE * 2, TILE_SIZE, {139, 115, 85, 255});
+        theme.AddOutline(leftShelfX, shelfY, TILE_SIZE * 2, TILE_SIZE, {100, 80, 60, 255});
+        theme.AddRect(rightShelfX, shelfY, TILE_SIZE * 2, TILE_SIZE, {139, 115, 85, 255});
+        theme.AddOutline(rightShelfX, shelfY, TILE_SIZE * 2, TILE_SIZE, {100, 80, 60, 255});
+        
+        // Blue and red potions
+        for (int j = 0; j < 4; j++) {
+            PixelColor bottleColor = (j % 2 == 0) ? PixelColor{0, 150, 255, 255} : PixelColor{255, 100, 100, 255};
+            theme.AddRect(leftShelfX + 8 + j * 12, shelfY - 8, 8, 12, bottleColor);
+            theme.AddOutline(leftShelfX + 8 + j * 12, shelfY - 8, 8, 12, {200, 200, 200, 255});
+            theme.AddRect(rightShelfX + 8 + j * 12, shelfY - 8, 8, 12, bottleColor);
+            theme.AddOutline(rightShelfX + 8 + j * 12, shelfY - 8, 8, 12, {200, 200, 200, 255});
+        }
+    }
+    
+    // Medical cot in the corner
+    int cotX = (RoomTheme::GRID_WIDTH - 6) * TILE_SIZE;
+    int cotY = (RoomTheme::GRID_HEIGHT - 4) * TILE_SIZE;
+    theme.AddRect(cotX, cotY, TILE_SIZE * 4, TILE_SIZE * 2, {139, 115, 85, 255});
+    theme.AddOutline(cotX, cotY, TILE_SIZE * 4, TILE_SIZE * 2, {100, 80, 60, 255});
+    theme.AddRect(cotX + 4, cotY + 4, TILE_SIZE * 4 - 8, TILE_SIZE * 2 - 8, {240, 240, 240, 255}); // Sheet
+    
+    // Hanging herbs from ceiling
+    for (int i = 0; i < 4; i++) {
+        int herbX = (4 + i * 3) * TILE_SIZE + 8;
+        int herbY = 2 * TILE_SIZE;
+        theme.AddRect(herbX + 6, herbY, 2, 16, {139, 115, 85, 255}); // String
+        theme.AddRect(herbX, herbY + 16, 16, 12, {0, 128, 0, 255});
+        theme.AddOutline(herbX, herbY + 16, 16, 12, {0, 100, 0, 255});
+        for (int j = 0; j < 3; j++) {
+            theme.AddRect(herbX + 2 + j * 4, herbY + 14, 4, 4, {50, 150, 50, 255});
+        }
+    }
+    
+    // Medicine table in center
+    int tableX = 10 * TILE_SIZE;
+    int tableY = 8 * TILE_SIZE;
+    theme.AddRect(tableX, tableY, TILE_SIZE * 3, TILE_SIZE * 2, {160, 130, 100, 255});
+    theme.AddOutline(tableX, tableY, TILE_SIZE * 3, TILE_SIZE * 2, {120, 90, 70, 255});
+    theme.AddRect(tableX + 8, tableY + 4, 12, 8, {200, 200, 200, 255}); // Bandages
+    theme.AddRect(tableX + 24, tableY + 8, 8, 12, {150, 75, 0, 255}); // Medicine bottle
+    theme.AddRect(tableX + 36, tableY + 6, 16, 6, {255, 255, 200, 255}); // Plaster
+    
     room->AddItem(Item("plaster", "A magical healing plaster that restores 20 health.", true, ItemType::MISC, 0, 0));
     
     return room;
@@ -182,6 +604,68 @@ std::unique_ptr<Room> RoomFactory::CreateSunlitMeadow() {
     auto room = std::make_unique<Room>("Sunlit Meadow", 
         "You emerge into a beautiful meadow filled with wildflowers and tall grass. The warm sun shines down on your face as a gentle breeze carries the scent of freedom. Birds chirp in the distance, and you can see rolling hills stretching to the horizon.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({144, 238, 144, 255});
+    
+    // Dungeon exit at the top center of the room
+    int exitX = TILE_SIZE * 11;
+    int exitY = TILE_SIZE;
+    theme.AddRect(exitX, exitY, TILE_SIZE * 2, 20, {139, 69, 19, 255}); // Wooden door
+    theme.AddRect(exitX + 8, exitY + 6, 8, 8, {160, 82, 45, 255}); // Door handle
+    theme.AddOutline(exitX, exitY, TILE_SIZE * 2, 20, {101, 67, 33, 255});
+    
+    // Flowers with centers and simple stems
+    PixelColor flowerColors[] = {
+        {255, 100, 100, 255}, // Red
+        {255, 255, 100, 255}, // Yellow
+        {100, 150, 255, 255}, // Blue
+        {255, 150, 200, 255}  // Pink
+    };
+    for (int i = 0; i < 8; i++) {
+        int flowerX = TILE_SIZE * (3 + (i * 2) % 18);
+        int flowerY = TILE_SIZE * (4 + (i * 3) % 10);
+        theme.AddRect(flowerX, flowerY, 16, 16, flowerColors[i % 4]);
+        theme.AddRect(flowerX + 4, flowerY + 4, 8, 8, {255, 255, 0, 255}); // Yellow center
+        theme.AddOutline(flowerX, flowerY, 16, 16, {200, 200, 200, 255});
+        theme.AddRect(flowerX + 6, flowerY + 16, 4, 12, {0, 128, 0, 255}); // Stem
+    }
+    
+    // Trees
+    for (int i = 0; i < 4; i++) {
+        int treeX = TILE_SIZE * (2 + i * 5);
+        int treeY = TILE_SIZE * 12;
+        theme.AddRect(treeX + 8, treeY + 16, 16, TILE_SIZE * 2, {101, 67, 33, 255}); // Trunk
+        theme.AddOutline(treeX + 8, treeY + 16, 16, TILE_SIZE * 2, {80, 50, 20, 255});
+        theme.AddRect(treeX, treeY, TILE_SIZE, 24, {34, 139, 34, 255}); // Leaves
+        theme.AddRect(treeX + 4, treeY - 8, 24, 16, {50, 205, 50, 255}); // Lighter top
+        theme.AddOutline(treeX, treeY, TILE_SIZE, 24, {0, 100, 0, 255});
+    }
+    
+    // Grass patches
+    for (int i = 0; i < 12; i++) {
+        int grassX = TILE_SIZE * (1 + (i * 2) % 22);
+        int grassY = TILE_SIZE * (6 + (i * 2) % 8);
+        theme.AddRect(grassX, grassY, 8, 12, {50, 150, 50, 255});
+        theme.AddRect(grassX + 8, grassY + 2, 6, 8, {60, 160, 60, 255});
+    }
+    
+    // Rocks
+    for (int i = 0; i < 4; i++) {
+        int rockX = TILE_SIZE * (6 + i * 3);
+        int rockY = TILE_SIZE * (8 + i % 3);
+        theme.AddRect(rockX, rockY, 20, 16, {128, 128, 128, 255});
+        theme.AddRect(rockX + 4, rockY - 6, 12, 8, {160, 160, 160, 255}); // Lighter top
+        theme.AddOutline(rockX, rockY, 20, 16, {100, 100, 100, 255});
+    }
+    
+    // Path to exit
+    for (int i = 0; i < 4; i++) {
+        int pathX = TILE_SIZE * (11 + (i % 2));
+        int pathY = TILE_SIZE * (3 + i);
+        theme.AddRect(pathX, pathY, 16, 16, {192, 192, 192, 255});
+        theme.AddOutline(pathX, pathY, 16, 16, {128, 128, 128, 255});
+    }
+    
     room->AddItem(Item("note", "A weathered piece of parchment, torn and yellowed with age.", true, ItemType::MISC, 0, 0));
     
     return room;
@@ -191,6 +675,49 @@ std::unique_ptr<Room> RoomFactory::CreateDarkRoom() {
     auto room = std::make_unique<Room>("Dark Room", 
         "You find yourself in a pitch-black underground chamber. The only light comes from glowing crystals embedded in the walls, casting eerie shadows that dance and flicker. The air is thick with ancient magic, and you sense you are not alone here.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({32, 32, 48, 255}); // Very dark blue-gray for mysterious room
+    
+    // Glowing crystals on walls
+    for (int i = 0; i < 8; i++) {
+        PixelColor crystalColor;
+        switch (i % 3) {
+            case 0: crystalColor = {100, 200, 255, 255}; break; // Blue
+            case 1: crystalColor = {200, 100, 255, 255}; break; // Purple
+            default: crystalColor = {255, 200, 100, 255}; break; // Orange
+        }
+        
+        // Four on the left wall, four on the right
+        int crystalX = (i < 4) ? 2 * TILE_SIZE : (RoomTheme::GRID_WIDTH - 3) * TILE_SIZE;
+        int crystalY = (3 + (i % 4) * 3) * TILE_SIZE;
+        
+        theme.AddRect(crystalX, crystalY, 16, 24, crystalColor);
+        theme.AddRect(crystalX + 4, crystalY - 8, 8, 16, crystalColor);
+        theme.AddRect(crystalX + 8, crystalY - 12, 4, 8, crystalColor);
+        theme.AddOutline(crystalX, crystalY, 16, 24, {(unsigned char)(crystalColor.r - 50), (unsigned char)(crystalColor.g - 50),
+                                                     (unsigned char)(crystalColor.b - 50), 255});
+        
+        // Glowing effect
+        for (int glow = 0; glow < 3; glow++) {
+            PixelColor glowColor = {crystalColor.r, crystalColor.g, crystalColor.b, (unsigned char)(50 - glow * 15)};
+            theme.AddOutline(crystalX - glow, crystalY - glow, 16 + glow * 2, 24 + glow * 2, glowColor);
+        }
+    }
+    
+    // Mysterious stone pedestal in center
+    int altarX = 10 * TILE_SIZE;
+    int altarY = 8 * TILE_SIZE;
+    theme.AddRect(altarX, altarY, TILE_SIZE * 2, TILE_SIZE, {60, 60, 80, 255});
+    theme.AddOutline(altarX, altarY, TILE_SIZE * 2, TILE_SIZE, {40, 40, 60, 255});
+    
+    // Mystical orb on pedestal
+    theme.AddRect(altarX + 20, altarY - 8, 24, 24, {150, 50, 200, 255});
+    theme.AddOutline(altarX + 20, altarY - 8, 24, 24, {100, 30, 150, 255});
+    for (int glow = 0; glow < 4; glow++) {
+        theme.AddOutline(altarX + 20 - glow, altarY - 8 - glow, 24 + glow * 2, 24 + glow * 2,
+                         {150, 50, 200, (unsigned char)(30 - glow * 7)});
+    }
+    
     return room;
 }
 
@@ -198,6 +725,36 @@ std::unique_ptr<Room> RoomFactory::CreateChapel() {
     auto room = std::make_unique<Room>("Chapel", 
         "A small, sacred chamber with stone walls covered in ancient religious symbols. Candles flicker on a simple altar, casting dancing shadows across weathered religious carvings. The air is heavy with incense and reverence.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({96, 96, 112, 255}); // Stone gray for sacred space
+    
+    // Stone altar at the front center
+    int altarX = 8 * TILE_SIZE;
+    int altarY = 2 * TILE_SIZE;
+    theme.AddRect(altarX, altarY, TILE_SIZE * 4, TILE_SIZE * 2, {160, 160, 160, 255});
+    theme.AddOutline(altarX, altarY, TILE_SIZE * 4, TILE_SIZE * 2, {120, 120, 120, 255});
+    theme.AddRect(altarX + 56, altarY - 16, 8, 24, {255, 215, 0, 255}); // Cross
+    theme.AddRect(altarX + 48, altarY - 12, 24, 8, {255, 215, 0, 255});
+    
+    // Wooden pews
+    for (int i = 0; i < 3; i++) {
+        int pewX = (4 + i * 5) * TILE_SIZE;
+        int pewY = 8 * TILE_SIZE;
+        theme.AddRect(pewX, pewY, TILE_SIZE * 3, TILE_SIZE, {139, 69, 19, 255});
+        theme.AddOutline(pewX, pewY, TILE_SIZE * 3, TILE_SIZE, {101, 67, 33, 255});
+        theme.AddRect(pewX, pewY - 12, TILE_SIZE * 3, 12, {139, 69, 19, 255}); // Pew backs
+        theme.AddOutline(pewX, pewY - 12, TILE_SIZE * 3, 12, {101, 67, 33, 255});
+    }
+    
+    // Candle stands
+    for (int i = 0; i < 4; i++) {
+        int candleX = (3 + i * 4) * TILE_SIZE;
+        int candleY = 12 * TILE_SIZE;
+        theme.AddRect(candleX, candleY, 8, 20, {255, 215, 0, 255});
+        theme.AddOutline(candleX, candleY, 8, 20, {200, 170, 0, 255});
+        theme.AddRect(candleX + 2, candleY - 8, 4, 8, {255, 150, 0, 255}); // Flame
+    }
+    
     // Add guardian creature
     room->AddMonster(Monster("guardian spirit", "A translucent figure in ancient robes, protecting the sacred diamond.", 35, 10, 12.0f, 6.0f));
     
@@ -210,6 +767,38 @@ std::unique_ptr<Room> RoomFactory::CreateSleepingQuarters() {
     auto room = std::make_unique<Room>("Sleeping Quarters", 
         "A modest room with simple stone beds arranged along the walls. Faded tapestries hang between the sleeping areas, and a few personal belongings are scattered about. Dust motes dance in the dim light filtering through a small window.");
     
+    RoomTheme& theme = room->GetTheme();
+    theme.SetFloorColor({112, 96, 80, 255}); // Warm wood tone for bedrooms
+    
+    // Beds along the walls
+    for (int i = 0; i < 4; i++) {
+        int bedX = (2 + (i % 2) * 10) * TILE_SIZE;
+        int bedY = (3 + (i / 2) * 6) * TILE_SIZE;
+        theme.AddRect(bedX, bedY, TILE_SIZE * 4, TILE_SIZE * 2, {139, 69, 19, 255});
+        theme.AddOutline(bedX, bedY, TILE_SIZE * 4, TILE_SIZE * 2, {101, 67, 33, 255});
+        theme.AddRect(bedX + 4, bedY + 4, TILE_SIZE * 4 - 8, TILE_SIZE * 2 - 8, {255, 248, 220, 255}); // Mattress
+        theme.AddRect(bedX + 8, bedY + 8, 24, 16, {200, 200, 255, 255}); // Pillow
+        theme.AddOutline(bedX + 8, bedY + 8, 24, 16, {150, 150, 200, 255});
+    }
+    
+    // Personal belongings (chests)
+    for (int i = 0; i < 4; i++) {
+        int chestX = (3 + (i % 2) * 10) * TILE_SIZE;
+        int chestY = (6 + (i / 2) * 6) * TILE_SIZE;
+        theme.AddRect(chestX, chestY, TILE_SIZE, 16, {160, 82, 45, 255});
+        theme.AddOutline(chestX, chestY, TILE_SIZE, 16, {120, 60, 30, 255});
+        theme.AddRect(chestX + 12, chestY + 6, 8, 6, {255, 215, 0, 255}); // Lock
+    }
+    
+    // Hanging lanterns
+    for (int i = 0; i < 2; i++) {
+        int lanternX = (6 + i * 8) * TILE_SIZE;
+        int lanternY = TILE_SIZE;
+        theme.AddRect(lanternX, lanternY, 16, 20, {255, 215, 0, 255});
+        theme.AddOutline(lanternX, lanternY, 16, 20, {200, 170, 0, 255});
+        theme.AddRect(lanternX + 4, lanternY + 4, 8, 12, {255, 255, 150, 180}); // Light glow
+    }
+    
     // Add nightmare creature
     room->AddMonster(Monster("nightmare wraith", "A dark, shadowy creature that haunts sleeping minds and guards the opal.", 30, 9, 8.0f, 10.0f));
     
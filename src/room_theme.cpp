@@ -0,0 +1,16 @@
+#include "room_theme.h"
+
+RoomTheme::RoomTheme() : floorColor({96, 80, 64, 255}) {}
+
+void RoomTheme::AddRect(int x, int y, int width, int height, PixelColor color) {
+    props.push_back({PropShape::FILLED, x, y, width, height, color});
+}
+
+void RoomTheme::AddOutline(int x, int y, int width, int height, PixelColor color) {
+    props.push_back({PropShape::OUTLINE, x, y, width, height, color});
+}
+
+void RoomTheme::AddObstacle(int tileX, int tileY, int tilesWide, int tilesHigh, PixelColor color) {
+    AddRect(tileX * TILE_SIZE, tileY * TILE_SIZE, tilesWide * TILE_SIZE, tilesHigh * TILE_SIZE, color);
+    obstacles.push_back({tileX, tileY, tilesWide, tilesHigh});
+}
\ No newline at end of file
@@ -0,0 +1,1243 @@
+#include "simulation.h"
+#include "room_factory.h"
+#include "replay.h"
+#include "snapshot.h"
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+
+// Names the rules refer to directly, interned once up front
+static const Name ARMORY("Armory");
+static const Name SUNLIT_MEADOW("Sunlit Meadow");
+static const Name DARK_ROOM("Dark Room");
+static const Name THRONE_ROOM("Throne Room");
+static const Name GOLD("gold");
+static const Name STAFF("staff");
+static const Name DIAMOND("diamond");
+static const Name EMERALD("emerald");
+static const Name OPAL("opal");
+
+Simulation::Simulation(const std::string& logSpillPath, uint64_t seed, int depthRooms) : messageLog(MAX_MESSAGES, logSpillPath), echo(nullptr), recorder(nullptr), replaying(false), worldGeneration(0), viewRevision(0), backgroundRoomId(-1), backgroundRoomRevision(0), backgroundWorldGeneration(0) {
+    state.rng.Seed(seed);
+    
+    // Character selection
+    AddMessage("Welcome to the Retro Dungeon!");
+    AddMessage("Choose your character: Type 'male' or 'female'");
+    AddMessage("");
+    
+    InitializeDungeon(depthRooms);
+    AddMessage("Welcome to the Retro Dungeon!");
+    AddMessage("Type 'help' for commands, 'look' to examine your surroundings.");
+    AddMessage("Use 'go north', 'go south', 'go east', 'go west' to move.");
+}
+
+void Simulation::SubmitCommand(const std::string& command) {
+    if (recorder) recorder->RecordCommand(state.tick, command);
+    AddMessage("> " + command);
+    ExecuteCommand(command);
+    viewRevision++;
+}
+
+void Simulation::Tick(const TickInput& input) {
+    if (recorder) recorder->RecordInput(state.tick, input);
+    
+    state.tick++;
+    state.moveTicks++;
+    state.animTicks++;
+    
+    // What the view showed before this tick, to tell whether it has to be drawn again
+    float viewX = state.playerRoomX, viewY = state.playerRoomY;
+    int viewWalkFrame = state.walkAnimFrame;
+    int viewEndingPhase = state.endingPhase;
+    bool viewMapOpen = state.inMapView;
+    
+    // Renderers interpolate from where everything stood before this tick
+    SnapInterpolation();
+    
+    // Handle ending sequence transitions
+    if (state.endingPhase > 0) {
+        state.endingTicks++;
+        
+        // Transition every 1.5 seconds
+        if (state.endingTicks >= ENDING_PHASE_TICKS) {
+            state.endingPhase++;
+            state.endingTicks = 0;
+            
+            if (state.endingPhase > 5) {
+                state.endingPhase = 5; // Stay at game over
+            }
+        }
+    }
+    
+    // Walking animation - cycle through frames (much slower, each pose held longer)
+    if (state.isWalking && state.animTicks >= WALK_FRAME_TICKS) {
+        state.walkAnimFrame = (state.walkAnimFrame + 1) % 4; // 4 frame walk cycle, each held longer
+        state.animTicks = 0;
+    }
+    
+    // Retro movement - grid-based with animation (Arrow keys only)
+    bool keyPressed = false;
+    if (state.moveTicks >= PLAYER_MOVE_TICKS) { // Slightly faster for smoother animation
+        if (input.up) {
+            MovePlayer(0, -1);
+            state.moveTicks = 0;
+            keyPressed = true;
+        }
+        else if (input.down) {
+            MovePlayer(0, 1);
+            state.moveTicks = 0;
+            keyPressed = true;
+        }
+        else if (input.left) {
+            MovePlayer(-1, 0);
+            state.moveTicks = 0;
+            keyPressed = true;
+        }
+        else if (input.right) {
+            MovePlayer(1, 0);
+            state.moveTicks = 0;
+            keyPressed = true;
+        }
+    }
+    
+    // Update walking state
+    state.isWalking = keyPressed || input.up || input.down || input.left || input.right;
+    
+    if (!state.isWalking) {
+        state.walkAnimFrame = 0; // Reset to idle frame
+    }
+    
+    // Attack with Delete key or Spacebar
+    if (input.attack) {
+        AttackNearestMonster();
+    }
+    
+    // Exit map view with Shift key
+    if (input.closeMap) {
+        if (state.inMapView) {
+            state.inMapView = false;
+            AddMessage("Closing map view.");
+        }
+    }
+    
+    UpdateMonsters();
+    UpdateBackgroundMonsters();
+    CheckMonsterCollisions();
+    
+    if (state.playerRoomX != viewX || state.playerRoomY != viewY || state.walkAnimFrame != viewWalkFrame ||
+        state.endingPhase != viewEndingPhase || state.inMapView != viewMapOpen) {
+        viewRevision++;
+    }
+}
+
+int Simulation::TicksUntilNextEvent() const {
+    int next = NO_PENDING_EVENT;
+    auto consider = [&next](int ticks) {
+        ticks = std::max(ticks, 1);
+        if (next == NO_PENDING_EVENT || ticks < next) next = ticks;
+    };
+    
+    // Phases 1 to 4 give way to the next; game over stays
+    if (state.endingPhase > 0 && state.endingPhase < 5) {
+        consider(ENDING_PHASE_TICKS - state.endingTicks);
+    }
+    
+    // Walking only lasts while a key is held, but until the next tick sees it released
+    // the player may still step or change pose
+    if (state.isWalking) {
+        consider(PLAYER_MOVE_TICKS - state.moveTicks);
+        consider(WALK_FRAME_TICKS - state.animTicks);
+    }
+    
+    if (state.currentRoom) {
+        const MonsterStore& monsters = state.monsters;
+        for (size_t i = monsters.RoomBegin(state.currentRoom->GetId()); i < monsters.RoomEnd(state.currentRoom->GetId()); i++) {
+            if (!monsters.alive[i]) continue;
+            consider(MONSTER_MOVE_TICKS - monsters.moveTicks[i]);
+            if (monsters.isAggro[i]) {
+                uint64_t sinceAttack = state.tick - state.lastMonsterAttackTick;
+                consider(sinceAttack >= MONSTER_ATTACK_TICKS ? 1 : MONSTER_ATTACK_TICKS - (int)sinceAttack);
+            }
+        }
+    }
+    return next;
+}
+
+void Simulation::ExecuteCommand(const std::string& command) {
+    const std::vector<std::string_view>& commandWords = commandTokenizer.SplitLower(command, ' ');
+    
+    if (commandWords.empty()) return;
+    
+    const CommandSpec* spec = FindCommand(commandWords[0]);
+    if (!spec || (spec->needsArgument && commandWords.size() < 2)) {
+        AddMessage("I don't understand that command.");
+        return;
+    }
+    (this->*spec->handler)(commandWords.size() > 1 ? commandWords[1] : std::string_view());
+}
+
+// Every verb the interpreter understands, aliases included. Commands that need an
+// argument aren't understood without one. Only the second word is ever passed on.
+const Simulation::CommandSpec Simulation::COMMANDS[] = {
+    {"help", false, &Simulation::HandleHelp},
+    {"male", false, &Simulation::HandleMale},
+    {"female", false, &Simulation::HandleFemale},
+    {"look", false, &Simulation::HandleLook},
+    {"go", true, &Simulation::HandleGo},
+    {"take", true, &Simulation::HandleTake},
+    {"inventory", false, &Simulation::HandleInventory},
+    {"inv", false, &Simulation::HandleInventory},
+    {"equip", true, &Simulation::HandleEquip},
+    {"drop", true, &Simulation::HandleDrop},
+    {"stats", true, &Simulation::HandleStats},
+    {"use", true, &Simulation::HandleUse},
+    {"map", false, &Simulation::HandleMap},
+    {"combine", false, &Simulation::HandleCombine},
+    {"continue", false, &Simulation::HandleContinue},
+    {"save", false, &Simulation::HandleSave},
+    {"load", false, &Simulation::HandleLoad},
+    {"quit", false, &Simulation::HandleQuit},
+};
+
+const Simulation::CommandSpec* Simulation::FindCommand(std::string_view verb) {
+    // Built on first use; the keys point at the table's string literals
+    static const std::unordered_map<std::string_view, const CommandSpec*> index = [] {
+        std::unordered_map<std::string_view, const CommandSpec*> byVerb;
+        for (const auto& spec : COMMANDS) {
+            byVerb.emplace(spec.verb, &spec);
+        }
+        return byVerb;
+    }();
+    
+    auto it = index.find(verb);
+    return it != index.end() ? it->second : nullptr;
+}
+
+void Simulation::HandleHelp(std::string_view) {
+    AddMessage("=== COMMAND HELP ===");
+    AddMessage("");
+    AddMessage("MOVEMENT:");
+    AddMessage("  go [direction] - Move to another room (north, south, east, west)");
+    AddMessage("  Arrow Keys - Move character within room");
+    AddMessage("");
+    AddMessage("EXPLORATION:");
+    AddMessage("  look - Examine current room and see exits");
+    AddMessage("  take [item] - Pick up an item from the room");
+    AddMessage("  inventory (or inv) - View your carried items");
+    AddMessage("  use [item] - Use an item from your inventory");
+    AddMessage("  map - View dungeon map (requires scroll)");
+    AddMessage("");
+    AddMessage("EQUIPMENT:");
+    AddMessage("  equip [item] - Equip any item (weapons give attack, armor gives protection)");
+    AddMessage("  drop [item] - Drop an item from inventory to current room");
+    AddMessage("  stats [item] - View detailed item statistics and bonuses");
+    AddMessage("");
+    AddMessage("COMBAT:");
+    AddMessage("  DELETE/SPACEBAR - Attack nearby monsters");
+    AddMessage("  Get close to monsters (within 3 tiles) to attack them");
+    AddMessage("");
+    AddMessage("CHARACTER:");
+    AddMessage("  male - Set character as male");
+    AddMessage("  female - Set character as female");
+    AddMessage("");
+    AddMessage("INTERFACE:");
+    AddMessage("  Page Up/Page Down - Scroll through chat history");
+    AddMessage("  Mouse Wheel - Scroll through chat history");
+    AddMessage("  Hold TAB - Fast-forward time");
+    AddMessage("  save - Save your progress");
+    AddMessage("  load - Return to your last save");
+    AddMessage("  help - Show this help screen");
+    AddMessage("  quit - Exit the game");
+}
+
+void Simulation::HandleMale(std::string_view) {
+    state.isFemale = false;
+    AddMessage("You are now a male character.");
+}
+
+void Simulation::HandleFemale(std::string_view) {
+    state.isFemale = true;
+    AddMessage("You are now a female character.");
+}
+
+void Simulation::HandleLook(std::string_view) {
+    AddMessage(state.currentRoom->GetName().GetText());
+    
+    // Get description with exits included
+    std::string fullDesc = state.currentRoom->GetDescription(state.monsters);
+    auto exits = state.currentRoom->GetExits();
+    if (!exits.empty()) {
+        fullDesc += "\n\nExits: ";
+        for (size_t i = 0; i < exits.size(); ++i) {
+            if (i > 0) fullDesc += ", ";
+            fullDesc += exits[i];
+        }
+    }
+    
+    // Add locked exits for armory
+    if (state.currentRoom->GetName() == ARMORY && !state.hasKey) {
+        if (!exits.empty()) {
+            fullDesc += ", east (locked)";
+        } else {
+            fullDesc += "\n\nExits: east (locked)";
+        }
+    }
+    
+    AddMessage(fullDesc);
+}
+
+void Simulation::HandleGo(std::string_view argument) {
+    std::string direction(argument);
+    
+    // Check for locked doors
+    if (state.currentRoom->GetName() == ARMORY && direction == "east" && !state.hasKey) {
+        AddMessage("The door to the east is locked with a heavy iron lock.");
+        AddMessage("You need a key to open it.");
+        return;
+    }
+    
+    Room* nextRoom = state.currentRoom->GetExit(direction);
+    
+    if (nextRoom) {
+        state.currentRoom = nextRoom;
+        state.currentRoom->SetVisited(true);
+        state.playerRoomX = 10.0f;
+        state.playerRoomY = 8.0f;
+        SnapInterpolation();
+        
+        AddMessage("You go " + direction + ".");
+        AddMessage(state.currentRoom->GetName().GetText());
+        
+        // Check for win condition
+        if (state.currentRoom->GetName() == SUNLIT_MEADOW) {
+            AddMessage("After what feels like an eternity in the dark dungeon, you finally breathe fresh air!");
+            AddMessage("The nightmare is over. You have escaped the Retro Dungeon!");
+            AddMessage("");
+            AddMessage("=== GAME OVER. YOU WIN! ===");
+            AddMessage("...or do you?");
+            AddMessage("");
+            AddMessage("Thank you for playing! Press any key to continue exploring...");
+            return; // Don't show exits or description for ending
+        }
+        
+        // Check for dark room stranger interaction
+        if (state.currentRoom->GetName() == DARK_ROOM && !state.strangeMet) {
+            AddMessage("A mysterious figure emerges from the shadows...");
+            AddMessage("'Welcome, traveler,' whispers a hooded stranger with glowing eyes.");
+            AddMessage("'I seek gold... in exchange for something truly special.'");
+            
+            // Check if player has gold
+            bool hasGold = false;
+            for (const auto& item : state.inventory) {
+                if (item.name == GOLD) {
+                    hasGold = true;
+                    break;
+                }
+            }
+            
+            if (hasGold) {
+                AddMessage("'I see you carry gold... use it here if you wish to trade.'");
+            } else if (state.hasKey) {
+                AddMessage("'You seek gold? Take a look in the treasure chamber...'");
+            } else {
+                AddMessage("'You seek gold? Maybe you can find a key in the basement to unlock another room...'");
+            }
+        }
+        
+        // Get description with exits included
+        std::string fullDesc = state.currentRoom->GetDescription(state.monsters);
+        auto exits = state.currentRoom->GetExits();
+        if (!exits.empty()) {
+            fullDesc += "\n\nExits: ";
+            for (size_t i = 0; i < exits.size(); ++i) {
+                if (i > 0) fullDesc += ", ";
+                fullDesc += exits[i];
+            }
+        }
+        
+        // Add locked exits for armory
+        if (state.currentRoom->GetName() == ARMORY && !state.hasKey) {
+            if (!exits.empty()) {
+                fullDesc += ", east (locked)";
+            } else {
+                fullDesc += "\n\nExits: east (locked)";
+            }
+        }
+        
+        AddMessage(fullDesc);
+    } else {
+        AddMessage("You can't go that way.");
+    }
+}
+
+void Simulation::HandleTake(std::string_view argument) {
+    std::string itemName(argument);
+    Name wanted = Name::Find(itemName);
+    
+    // Find the item in the room first to get its full details
+    const auto& roomItems = state.currentRoom->GetItems();
+    Item* foundItem = nullptr;
+    for (const auto& item : roomItems) {
+        if (item.name == wanted && item.takeable) {
+            foundItem = const_cast<Item*>(&item);
+            break;
+        }
+    }
+    
+    if (foundItem && state.currentRoom->RemoveItem(wanted)) {
+        state.inventory.push_back(*foundItem); // Copy the complete item with all its properties
+        
+        // Special interactions for specific items
+        if (itemName == "book" && !state.bookTaken) {
+            state.bookTaken = true;
+            AddMessage("You take the ancient tome. As you lift it, you notice a hidden lever behind it!");
+            AddMessage("You pull the lever and hear a rumbling sound from somewhere nearby...");
+            AddMessage("A secret passage has opened in the library! You can now go 'south' to the Infirmary.");
+            
+            // Connect library to infirmary
+            Room* library = state.rooms[5].get();
+            Room* infirmary = state.rooms[10].get();
+            library->SetExit("south", infirmary);
+            infirmary->SetExit("north", library);
+            state.infirmaryRevealed = true;
+        }
+        else if (itemName == "scroll" && !state.scrollTaken) {
+            state.scrollTaken = true;
+            AddMessage("You take the mysterious scroll. As you unroll it, ancient symbols glow briefly!");
+            AddMessage("The scroll contains a map enchantment! You have learned the 'map' command.");
+            AddMessage("Use 'map' to view the entire dungeon layout.");
+            state.mapUnlocked = true;
+        }
+        else if (itemName == "key" && !state.hasKey) {
+            state.hasKey = true;
+            AddMessage("You take the rusty old key. It feels heavy and important in your hand.");
+            AddMessage("This key looks like it might unlock something significant...");
+            
+            // Unlock the path from armory to treasure chamber
+            Room* armory = state.rooms[1].get();
+            Room* treasure = state.rooms[2].get();
+            armory->SetExit("east", treasure);
+            
+            AddMessage("You hear a distant clicking sound from somewhere in the dungeon!");
+            AddMessage("The armory door to the east has been unlocked!");
+        }
+        else if (itemName == "gem") {
+            AddMessage("You take the sparkling ruby. Its inner light pulses mysteriously.");
+            AddMessage("This gem seems special... perhaps it belongs somewhere significant like a throne room?");
+        }
+        else if (itemName == "staff") {
+            AddMessage("You take the ancient wooden staff. The runes along its surface begin to glow faintly.");
+            AddMessage("This feels like an incredibly powerful artifact. You sense it was once whole...");
+            state.hasStaff = true;
+        }
+        else if (itemName == "diamond") {
+            AddMessage("You take the flawless diamond. It resonates with pure, brilliant energy.");
+            AddMessage("This diamond seems to be part of something greater...");
+            state.hasDiamond = true;
+        }
+        else if (itemName == "emerald") {
+            AddMessage("You take the brilliant emerald. It pulses with vibrant green light.");
+            AddMessage("You feel nature's power flowing through this gem...");
+            state.hasEmerald = true;
+        }
+        else if (itemName == "opal") {
+            AddMessage("You take the shimmering opal. It shifts through all colors of the rainbow.");
+            AddMessage("This opal seems to contain the essence of all elements...");
+            state.hasOpal = true;
+        }
+        
+        // Check if all staff parts are collected
+        if (state.hasStaff && state.hasDiamond && state.hasEmerald && state.hasOpal && !state.staffComplete) {
+            AddMessage("");
+            AddMessage("The four artifacts resonate with each other in your inventory!");
+            AddMessage("The staff parts seem to be calling out to be reunited...");
+            AddMessage("You sense you can now 'combine' them to restore the ancient staff!");
+        }
+        else {
+            AddMessage("You take the " + itemName + ".");
+        }
+    } else {
+        AddMessage("You can't take that.");
+    }
+}
+
+void Simulation::HandleInventory(std::string_view) {
+    if (state.inventory.empty()) {
+        AddMessage("Your inventory is empty.");
+    } else {
+        std::string invStr = "You are carrying: ";
+        for (size_t i = 0; i < state.inventory.size(); ++i) {
+            if (i > 0) invStr += ", ";
+            invStr += state.inventory[i].name.GetText();
+        }
+        AddMessage(invStr);
+    }
+}
+
+void Simulation::HandleEquip(std::string_view argument) {
+    EquipItem(std::string(argument));
+}
+
+void Simulation::HandleDrop(std::string_view argument) {
+    DropItem(std::string(argument));
+}
+
+void Simulation::HandleStats(std::string_view argument) {
+    ShowItemStats(std::string(argument));
+}
+
+void Simulation::HandleUse(std::string_view argument) {
+    UseItem(std::string(argument));
+}
+
+void Simulation::HandleMap(std::string_view) {
+    if (state.mapUnlocked) {
+        state.inMapView = true;
+        if (state.hasTeleport) {
+            AddMessage("Opening map view... Press SHIFT to exit. Click on any explored room to teleport there!");
+        } else {
+            AddMessage("Opening map view... Press SHIFT to exit.");
+        }
+    } else {
+        AddMessage("You need to take a better look in the library.");
+    }
+}
+
+void Simulation::HandleCombine(std::string_view) {
+    // Check if all staff parts are collected
+    if (state.hasStaff && state.hasDiamond && state.hasEmerald && state.hasOpal && !state.staffComplete) {
+        // Remove individual parts from inventory
+        for (auto it = state.inventory.begin(); it != state.inventory.end(); ) {
+            if (it->name == STAFF || it->name == DIAMOND || it->name == EMERALD || it->name == OPAL) {
+                it = state.inventory.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        
+        // Add the complete staff to inventory
+        state.inventory.push_back(Item("?????", "The Ancient Staff of Power, now fully restored with all three gems embedded in its head. It pulses with magical energy.", true, ItemType::WEAPON, 25, 0));
+        
+        // Set completion flag
+        state.staffComplete = true;
+        
+        // Victory message
+        AddMessage("The staff parts resonate with ancient power as you bring them together!");
+        AddMessage("The diamond, emerald, and opal float from your hands and embed themselves into the staff head.");
+        AddMessage("Light erupts from the completed staff as its true power is unleashed!");
+        AddMessage("You now wield the Ancient Staff of Power! (+25 attack)");
+        AddMessage("The way forward is now clear...");
+        
+    } else if (state.staffComplete) {
+        AddMessage("The staff is already complete and pulsing with power.");
+    } else {
+        AddMessage("You need to collect all the staff parts first:");
+        AddMessage("- The wooden staff");
+        AddMessage("- The diamond gem");
+        AddMessage("- The emerald gem");
+        AddMessage("- The opal gem");
+    }
+}
+
+void Simulation::HandleContinue(std::string_view) {
+    // Only understood while the ending is waiting on the player
+    if (!state.waitingForContinue) {
+        AddMessage("I don't understand that command.");
+        return;
+    }
+    
+    AddMessage("The world begins to change...");
+    state.waitingForContinue = false;
+    state.endingPhase = 1; // Start visual transition
+}
+
+bool Simulation::IsSaveFileLocked() {
+    // The save file isn't part of a replay, so reading it would break determinism and
+    // writing it while replaying would overwrite the player's real save
+    if (!recorder && !replaying) return false;
+    AddMessage("Saving and loading are turned off while a session is recorded or replayed.");
+    return true;
+}
+
+void Simulation::HandleSave(std::string_view) {
+    if (IsSaveFileLocked()) return;
+    if (SaveSnapshot(SAVE_PATH)) {
+        AddMessage("Game saved.");
+    } else {
+        AddMessage("The game could not be saved.");
+    }
+}
+
+void Simulation::HandleLoad(std::string_view) {
+    if (IsSaveFileLocked()) return;
+    if (LoadSnapshot(SAVE_PATH)) {
+        AddMessage("Game loaded. You are in the " + state.currentRoom->GetName().GetText() + ".");
+    } else {
+        AddMessage("There is no saved game to load.");
+    }
+}
+
+void Simulation::HandleQuit(std::string_view) {
+    AddMessage("Thanks for playing!");
+    state.shouldQuit = true;
+}
+
+bool Simulation::SaveSnapshot(const std::string& path) const {
+    return Snapshot::Save(state, path);
+}
+
+bool Simulation::LoadSnapshot(const std::string& path) {
+    if (!Snapshot::Load(state, path)) {
+        return false;
+    }
+    worldGeneration++;
+    viewRevision++;
+    return true;
+}
+
+void Simulation::MovePlayer(float deltaX, float deltaY) {
+    float newX = state.playerRoomX + deltaX;
+    float newY = state.playerRoomY + deltaY;
+    
+    if (state.currentRoom->IsWalkable((int)newX, (int)state.playerRoomY)) {
+        state.playerRoomX = newX;
+    }
+    
+    if (state.currentRoom->IsWalkable((int)state.playerRoomX, (int)newY)) {
+        state.playerRoomY = newY;
+    }
+    
+    if (state.playerRoomX < 1.5f) state.playerRoomX = 1.5f;
+    if (state.playerRoomX > ROOM_GRID_WIDTH - 2.5f) state.playerRoomX = ROOM_GRID_WIDTH - 2.5f;
+    if (state.playerRoomY < 1.5f) state.playerRoomY = 1.5f;
+    if (state.playerRoomY > ROOM_GRID_HEIGHT - 2.5f) state.playerRoomY = ROOM_GRID_HEIGHT - 2.5f;
+}
+
+void Simulation::SnapInterpolation() {
+    state.prevPlayerRoomX = state.playerRoomX;
+    state.prevPlayerRoomY = state.playerRoomY;
+    
+    // Only the current room is drawn; background steps snap their own monsters
+    if (!state.currentRoom) return;
+    MonsterStore& monsters = state.monsters;
+    size_t first = monsters.RoomBegin(state.currentRoom->GetId());
+    size_t last = monsters.RoomEnd(state.currentRoom->GetId());
+    std::copy(monsters.x.begin() + first, monsters.x.begin() + last, monsters.prevX.begin() + first);
+    std::copy(monsters.y.begin() + first, monsters.y.begin() + last, monsters.prevY.begin() + first);
+}
+
+void Simulation::UpdateMonsters() {
+    if (!state.currentRoom) return;
+    
+    MonsterStore& monsters = state.monsters;
+    size_t first = monsters.RoomBegin(state.currentRoom->GetId());
+    size_t count = monsters.RoomEnd(state.currentRoom->GetId()) - first;
+    if (monsterDistances.size() < count) monsterDistances.resize(count);
+    
+    monsters.UpdateAggro(first, first + count, state.playerRoomX, state.playerRoomY, monsterDistances.data());
+    
+    // Monster movement every 0.3 seconds (slower than player), in index order so the
+    // RNG is drawn from in the same order every run
+    for (size_t k = 0; k < count; k++) {
+        size_t i = first + k;
+        if (!monsters.alive[i] || monsters.moveTicks[i] < MONSTER_MOVE_TICKS) continue;
+        monsters.moveTicks[i] = 0;
+        
+        float x = monsters.x[i];
+        float y = monsters.y[i];
+        float& targetX = monsters.targetX[i];
+        float& targetY = monsters.targetY[i];
+        
+        if (monsters.isAggro[i] && monsterDistances[k] > 1.0f) {
+            // Move towards player along the flow field, one axis at a time for retro feel.
+            // The field is only rebuilt when the player has moved to another tile.
+            chaseField.Update(*state.currentRoom, (int)state.playerRoomX, (int)state.playerRoomY);
+            int stepX, stepY;
+            if (chaseField.NextStep((int)x, (int)y, stepX, stepY)) {
+                targetX = (float)stepX;
+                targetY = (float)stepY;
+                monsters.SetPosition(i, targetX, targetY);
+            }
+        } else if (!monsters.isAggro[i]) {
+            // Random wandering
+            WanderMonster(i, *state.currentRoom, state.rng.NextInt(5));
+        }
+        
+        if (monsters.x[i] != x || monsters.y[i] != y) {
+            viewRevision++;
+        }
+    }
+}
+
+void Simulation::UpdateBackgroundMonsters() {
+    if (!state.currentRoom) return;
+    
+    // Rebuild the neighbour list only when the player changes room, the room's exits
+    // change (its revision moves with them) or a save is loaded
+    int roomId = state.currentRoom->GetId();
+    unsigned int roomRevision = state.currentRoom->GetRevision();
+    if (roomId != backgroundRoomId || roomRevision != backgroundRoomRevision || worldGeneration != backgroundWorldGeneration) {
+        backgroundRoomId = roomId;
+        backgroundRoomRevision = roomRevision;
+        backgroundWorldGeneration = worldGeneration;
+        backgroundMonsters.clear();
+        for (const Room* room : state.currentRoom->GetAdjacentRooms()) {
+            if (room == state.currentRoom) continue;
+            for (size_t i = state.monsters.RoomBegin(room->GetId()); i < state.monsters.RoomEnd(room->GetId()); i++) {
+                backgroundMonsters.push_back({i, room});
+            }
+        }
+    }
+    
+    // This tick's share: every BACKGROUND_TICKS-th entry. The draws are keyed on tick and
+    // monster rather than taken from state.rng, so the current room's dice are unaffected.
+    MonsterStore& monsters = state.monsters;
+    for (size_t k = state.tick % BACKGROUND_TICKS; k < backgroundMonsters.size(); k += BACKGROUND_TICKS) {
+        size_t i = backgroundMonsters[k].index;
+        
+        // Nobody is watching, so no interpolation; an aggroed monster waits where it lost the player
+        if (!monsters.alive[i] || monsters.isAggro[i]) continue;
+        WanderMonster(i, *backgroundMonsters[k].room, state.rng.HashInt(state.tick, i, 5));
+        monsters.prevX[i] = monsters.x[i];
+        monsters.prevY[i] = monsters.y[i];
+    }
+}
+
+void Simulation::WanderMonster(size_t index, const Room& room, int direction) {
+    MonsterStore& monsters = state.monsters;
+    float x = monsters.x[index];
+    float y = monsters.y[index];
+    float& targetX = monsters.targetX[index];
+    float& targetY = monsters.targetY[index];
+    
+    switch (direction) {
+        case 0: targetX = x - 1; targetY = y; break;
+        case 1: targetX = x + 1; targetY = y; break;
+        case 2: targetX = x; targetY = y - 1; break;
+        case 3: targetX = x; targetY = y + 1; break;
+        default: return; // Stay still
+    }
+    
+    // Check boundaries and walkability
+    if (targetX >= 1.5f && targetX <= ROOM_GRID_WIDTH - 2.5f &&
+        targetY >= 1.5f && targetY <= ROOM_GRID_HEIGHT - 2.5f &&
+        room.IsWalkable((int)targetX, (int)targetY)) {
+        monsters.SetPosition(index, targetX, targetY);
+    }
+}
+
+void Simulation::CheckMonsterCollisions() {
+    if (!state.currentRoom) return;
+    
+    // Attack every 2 seconds
+    if (state.tick - state.lastMonsterAttackTick < MONSTER_ATTACK_TICKS) return;
+    
+    // If an aggroed monster is adjacent to player (within 1.5 tiles), initiate combat.
+    // Only one can hit per attack window: the first by index, as it always was.
+    MonsterStore& monsters = state.monsters;
+    size_t attacker = monsters.Size();
+    monsters.ForEachWithin(state.currentRoom->GetId(), state.playerRoomX, state.playerRoomY, 1.5f, [&](size_t i) {
+        if (monsters.isAggro[i] && i < attacker) attacker = i;
+    });
+    if (attacker == monsters.Size()) return;
+    
+    state.lastMonsterAttackTick = state.tick;
+    
+    int damage = monsters.attack[attacker] + state.rng.NextInt(5) - state.GetTotalArmor();
+    if (damage < 1) damage = 1; // Minimum damage
+    state.playerHealth -= damage;
+    
+    AddMessage("The " + monsters.name[attacker].GetText() + " attacks you for " + std::to_string(damage) + " damage!");
+    
+    if (state.playerHealth <= 0) {
+        AddMessage("You have been defeated! Game Over.");
+        state.playerHealth = 0;
+    }
+}
+
+void Simulation::AddMessage(const std::string& message) {
+    messageLog.Add(message);
+    viewRevision++;
+    if (echo) {
+        *echo << message << "\n";
+    }
+}
+
+void Simulation::InitializeDungeon(int depthRooms) {
+    // Create all rooms using RoomFactory
+    state.rooms = RoomFactory::CreateAllRooms(state.rng, depthRooms);
+    state.IndexRooms();
+    
+    // Connect the rooms
+    RoomFactory::ConnectRooms(state.rooms);
+    state.monsters.Build(state.rooms);
+    
+    // Set the starting room to entrance hall (first room)
+    state.currentRoom = state.rooms[0].get();
+    state.currentRoom->SetVisited(true);
+}
+
+Item* Simulation::FindItemInInventory(const std::string& itemName) {
+    Name wanted = Name::Find(itemName);
+    for (auto& item : state.inventory) {
+        if (item.name == wanted) {
+            return &item;
+        }
+    }
+    return nullptr;
+}
+
+int Simulation::FindItemIndexInInventory(const std::string& itemName) {
+    Name wanted = Name::Find(itemName);
+    for (int i = 0; i < (int)state.inventory.size(); ++i) {
+        if (state.inventory[i].name == wanted) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void Simulation::EquipItem(const std::string& itemName) {
+    int itemIndex = FindItemIndexInInventory(itemName);
+    if (itemIndex == -1) {
+        AddMessage("You don't have a " + itemName + " in your inventory.");
+        return;
+    }
+    
+    Item& item = state.inventory[itemIndex];
+    
+    // Auto-categorize items as weapon or armor based on their bonuses
+    bool isWeapon = (item.damageBonus > 0);
+    bool isArmor = (item.armorBonus > 0);
+    
+    if (isWeapon && isArmor) {
+        // If item has both bonuses, ask player to specify
+        AddMessage("The " + itemName + " can be used as weapon or armor. Use 'equip " + itemName + " weapon' or 'equip " + itemName + " armor'.");
+        return;
+    }
+    else if (isWeapon) {
+        // Equip as weapon - handle previous weapon
+        if (state.equippedWeaponIndex >= 0 && state.equippedWeaponIndex < (int)state.inventory.size()) {
+            AddMessage("You unequip the " + state.inventory[state.equippedWeaponIndex].name.GetText() + " and drop it.");
+            state.currentRoom->AddItem(state.inventory[state.equippedWeaponIndex]);
+            
+            // Remove the previously equipped weapon from inventory
+            int oldWeaponIndex = state.equippedWeaponIndex;
+            state.inventory.erase(state.inventory.begin() + oldWeaponIndex);
+            
+            // Adjust itemIndex if it's after the removed item
+            if (itemIndex > oldWeaponIndex) {
+                itemIndex--;
+            }
+            
+            // Adjust armor index if it's after the removed item
+            if (state.equippedArmorIndex > oldWeaponIndex) {
+                state.equippedArmorIndex--;
+            }
+            
+            state.equippedWeaponIndex = -1; // Reset first
+        }
+        
+        state.equippedWeaponIndex = itemIndex;
+        AddMessage("You equip the " + itemName + " as a weapon. (+" + std::to_string(item.damageBonus) + " attack)");
+    }
+    else if (isArmor) {
+        // Equip as armor - handle previous armor
+        if (state.equippedArmorIndex >= 0 && state.equippedArmorIndex < (int)state.inventory.size()) {
+            AddMessage("You unequip the " + state.inventory[state.equippedArmorIndex].name.GetText() + " and drop it.");
+            state.currentRoom->AddItem(state.inventory[state.equippedArmorIndex]);
+            
+            // Remove the previously equipped armor from inventory
+            int oldArmorIndex = state.equippedArmorIndex;
+            state.inventory.erase(state.inventory.begin() + oldArmorIndex);
+            
+            // Adjust itemIndex if it's after the removed item
+            if (itemIndex > oldArmorIndex) {
+                itemIndex--;
+            }
+            
+            // Adjust weapon index if it's after the removed item
+            if (state.equippedWeaponIndex > oldArmorIndex) {
+                state.equippedWeaponIndex--;
+            }
+            
+            state.equippedArmorIndex = -1; // Reset first
+        }
+        
+        state.equippedArmorIndex = itemIndex;
+        AddMessage("You equip the " + itemName + " as armor. (+" + std::to_string(item.armorBonus) + " protection)");
+    }
+    else {
+        // Default: try to equip as weapon slot (any item can be "equipped")
+        if (state.equippedWeaponIndex >= 0 && state.equippedWeaponIndex < (int)state.inventory.size()) {
+            AddMessage("You unequip the " + state.inventory[state.equippedWeaponIndex].name.GetText() + " and drop it.");
+            state.currentRoom->AddItem(state.inventory[state.equippedWeaponIndex]);
+            
+            // Remove the previously equipped weapon from inventory
+            int oldWeaponIndex = state.equippedWeaponIndex;
+            state.inventory.erase(state.inventory.begin() + oldWeaponIndex);
+            
+            // Adjust itemIndex if it's after the removed item
+            if (itemIndex > oldWeaponIndex) {
+                itemIndex--;
+            }
+            
+            // Adjust armor index if it's after the removed item
+            if (state.equippedArmorIndex > oldWeaponIndex) {
+                state.equippedArmorIndex--;
+            }
+            
+            state.equippedWeaponIndex = -1; // Reset first
+        }
+        
+        state.equippedWeaponIndex = itemIndex;
+        AddMessage("You equip the " + itemName + ". (No combat bonus)");
+    }
+}
+
+void Simulation::DropItem(const std::string& itemName) {
+    int itemIndex = FindItemIndexInInventory(itemName);
+    if (itemIndex == -1) {
+        AddMessage("You don't have a " + itemName + " to drop.");
+        return;
+    }
+    
+    // Unequip if equipped
+    if (state.equippedWeaponIndex == itemIndex) {
+        state.equippedWeaponIndex = -1;
+        AddMessage("You unequip the " + itemName + ".");
+    }
+    if (state.equippedArmorIndex == itemIndex) {
+        state.equippedArmorIndex = -1;
+        AddMessage("You unequip the " + itemName + ".");
+    }
+    
+    // Add to current room
+    state.currentRoom->AddItem(state.inventory[itemIndex]);
+    
+    // Adjust equipment indices if they reference items after the dropped item
+    if (state.equippedWeaponIndex > itemIndex) {
+        state.equippedWeaponIndex--;
+    }
+    if (state.equippedArmorIndex > itemIndex) {
+        state.equippedArmorIndex--;
+    }
+    
+    state.inventory.erase(state.inventory.begin() + itemIndex);
+    AddMessage("You drop the " + itemName + ".");
+}
+
+void Simulation::ShowItemStats(const std::string& itemName) {
+    int itemIndex = FindItemIndexInInventory(itemName);
+    if (itemIndex == -1) {
+        AddMessage("You don't have a " + itemName + " in your inventory.");
+        return;
+    }
+    
+    Item& item = state.inventory[itemIndex];
+    
+    AddMessage("=== " + item.name.GetText() + " STATS ===");
+    AddMessage(item.description);
+    AddMessage("");
+    
+    // Show current attack and armor values
+    int currentAttack = state.GetTotalAttack();
+    int currentArmor = state.GetTotalArmor();
+    
+    // Show what attack/armor would be with this item
+    if (item.damageBonus > 0) {
+        AddMessage("WEAPON DAMAGE: +" + std::to_string(item.damageBonus) + " attack bonus");
+        if (state.equippedWeaponIndex != itemIndex) {
+            int newAttack = state.basePlayerAttack + item.damageBonus;
+            AddMessage("Total attack with this weapon: " + std::to_string(newAttack) + 
+                      " (currently: " + std::to_string(currentAttack) + ")");
+        } else {
+            AddMessage("Currently equipped as weapon - contributing to your " + std::to_string(currentAttack) + " total attack");
+        }
+    } else {
+        AddMessage("WEAPON DAMAGE: +0 attack bonus");
+    }
+    
+    if (item.armorBonus > 0) {
+        AddMessage("ARMOR PROTECTION: +" + std::to_string(item.armorBonus) + " armor bonus");
+        if (state.equippedArmorIndex != itemIndex) {
+            int newArmor = state.basePlayerArmor + item.armorBonus;
+            AddMessage("Total armor with this item: " + std::to_string(newArmor) + 
+                      " (currently: " + std::to_string(currentArmor) + ")");
+        } else {
+            AddMessage("Currently equipped as armor - contributing to your " + std::to_string(currentArmor) + " total armor");
+        }
+    } else {
+        AddMessage("ARMOR PROTECTION: +0 armor bonus");
+    }
+    
+    AddMessage("");
+    
+    // Determine item classification
+    if (item.damageBonus > 0 && item.armorBonus > 0) {
+        AddMessage("TYPE: Hybrid (can be weapon or armor)");
+    } else if (item.damageBonus > 0) {
+        AddMessage("TYPE: Weapon");
+    } else if (item.armorBonus > 0) {
+        AddMessage("TYPE: Armor");
+    } else {
+        AddMessage("TYPE: Miscellaneous item");
+    }
+    
+    // Show equipment status
+    if (state.equippedWeaponIndex == itemIndex) {
+        AddMessage("STATUS: EQUIPPED as weapon (ERROR if armor item!)");
+    } else if (state.equippedArmorIndex == itemIndex) {
+        AddMessage("STATUS: EQUIPPED as armor");
+    } else {
+        AddMessage("STATUS: In inventory (not equipped)");
+    }
+}
+
+void Simulation::UseItem(const std::string& itemName) {
+    int itemIndex = FindItemIndexInInventory(itemName);
+    if (itemIndex == -1) {
+        AddMessage("You don't have a " + itemName + " to use.");
+        return;
+    }
+    
+    if (itemName == "plaster") {
+        if (state.playerHealth >= 100) {
+            AddMessage("You are already at full health!");
+            return;
+        }
+        
+        int healthBefore = state.playerHealth;
+        state.playerHealth += 20;
+        if (state.playerHealth > 100) state.playerHealth = 100;
+        
+        int healedAmount = state.playerHealth - healthBefore;
+        AddMessage("You use the magical plaster and heal for " + std::to_string(healedAmount) + " health!");
+        AddMessage("Your health is now " + std::to_string(state.playerHealth) + "/100.");
+        
+        // Remove the plaster from inventory (single use)
+        state.inventory.erase(state.inventory.begin() + itemIndex);
+        
+        // Adjust equipment indices if they reference items after the removed item
+        if (state.equippedWeaponIndex > itemIndex) {
+            state.equippedWeaponIndex--;
+        }
+        if (state.equippedArmorIndex > itemIndex) {
+            state.equippedArmorIndex--;
+        }
+        // If the removed item was equipped, unequip it
+        if (state.equippedWeaponIndex == itemIndex) {
+            state.equippedWeaponIndex = -1;
+        }
+        if (state.equippedArmorIndex == itemIndex) {
+            state.equippedArmorIndex = -1;
+        }
+        
+        AddMessage("The plaster dissolves after use.");
+    } else if (itemName == "gem" && state.currentRoom->GetName() == THRONE_ROOM) {
+        if (state.gemUsed) {
+            AddMessage("You have already used the gem here.");
+            return;
+        }
+        
+        state.gemUsed = true;
+        AddMessage("You approach the ancient throne and notice a ruby-shaped indentation in its armrest.");
+        AddMessage("You carefully place the sparkling ruby into the slot...");
+        AddMessage("*CLICK* The gem slots perfectly into place with a satisfying sound!");
+        AddMessage("Suddenly, the floor trembles and ancient mechanisms whir to life!");
+        AddMessage("A hidden door slides open in the south wall, revealing sunlight beyond!");
+        
+        // Create the exit to the meadow
+        Room* throne = state.rooms[8].get();
+        Room* meadow = state.rooms[11].get();
+        throne->SetExit("south", meadow);
+        meadow->SetExit("north", throne);
+        
+        // Remove the gem from inventory
+        state.inventory.erase(state.inventory.begin() + itemIndex);
+        
+        // Adjust equipment indices if they reference items after the removed item
+        if (state.equippedWeaponIndex > itemIndex) {
+            state.equippedWeaponIndex--;
+        }
+        if (state.equippedArmorIndex > itemIndex) {
+            state.equippedArmorIndex--;
+        }
+        // If the removed item was equipped, unequip it
+        if (state.equippedWeaponIndex == itemIndex) {
+            state.equippedWeaponIndex = -1;
+        }
+        if (state.equippedArmorIndex == itemIndex) {
+            state.equippedArmorIndex = -1;
+        }
+    } else if (itemName == "gem" && state.currentRoom->GetName() != THRONE_ROOM) {
+        AddMessage("The gem doesn't seem to have any effect here. Perhaps it belongs somewhere special...");
+    } else if (itemName == "gold" && state.currentRoom->GetName() == DARK_ROOM) {
+        if (state.strangeMet) {
+            AddMessage("You have already traded with the mysterious stranger.");
+            return;
+        }
+        
+        state.strangeMet = true;
+        state.hasTeleport = true;
+        AddMessage("The mysterious stranger's eyes gleam as you offer the gold.");
+        AddMessage("'Excellent...' the stranger whispers, taking the gold with bony fingers.");
+        AddMessage("'In return, I shall grant you the ancient art of teleportation...'");
+        AddMessage("Dark energy swirls around you as mystical knowledge floods your mind!");
+        AddMessage("You have learned TELEPORT! When viewing the map, click on any explored room to instantly travel there.");
+        
+        // Remove gold from inventory
+        state.inventory.erase(state.inventory.begin() + itemIndex);
+        
+        // Adjust equipment indices if they reference items after the removed item
+        if (state.equippedWeaponIndex > itemIndex) {
+            state.equippedWeaponIndex--;
+        }
+        if (state.equippedArmorIndex > itemIndex) {
+            state.equippedArmorIndex--;
+        }
+        if (state.equippedWeaponIndex == itemIndex) {
+            state.equippedWeaponIndex = -1;
+        }
+        if (state.equippedArmorIndex == itemIndex) {
+            state.equippedArmorIndex = -1;
+        }
+    } else if (itemName == "gold" && state.currentRoom->GetName() != DARK_ROOM) {
+        AddMessage("The gold feels heavy in your hands, but there's nothing to spend it on here.");
+    } else if (itemName == "note" && !state.noteRead) {
+        AddMessage("You carefully unfold the ancient, weathered parchment and read:");
+        AddMessage("");
+        AddMessage("'To whoever finds this cursed record...'");
+        AddMessage("'I have done something terrible. The Ancient Staff of [text torn]'");
+        AddMessage("'...possessed unimaginable power. In my hubris, I tried to control it.'");
+        AddMessage("'The magic was too strong. It nearly destroyed everything.'");
+        AddMessage("");
+        AddMessage("'I have broken the staff into four parts and hidden them:'");
+        AddMessage("'- The Staff itself, where meals are prepared'");
+        AddMessage("'- The Diamond, in a place of prayer and reverence'");
+        AddMessage("'- The Emerald, where wine sleeps in darkness'");
+        AddMessage("'- The Opal, where the weary rest their heads'");
+        AddMessage("");
+        AddMessage("'I have sealed these places with guardians and creatures.'");
+        AddMessage("'The staff must never be whole again, for its true power is...'");
+        AddMessage("[The rest of the note is torn and unreadable]");
+        AddMessage("");
+        AddMessage("You feel a strange energy pulse through the dungeon...");
+        
+        state.noteRead = true;
+        
+        // Reveal the Chapel (east of Sunlit Meadow)
+        Room* sunlitMeadow = state.rooms[11].get();
+        Room* chapel = state.rooms[13].get();
+        sunlitMeadow->SetExit("east", chapel);
+        chapel->SetExit("west", sunlitMeadow);
+        
+        // Reveal the Sleeping Quarters (north of Throne Room)
+        Room* throneRoom = state.rooms[8].get();
+        Room* sleepingQuarters = state.rooms[14].get();
+        throneRoom->SetExit("north", sleepingQuarters);
+        sleepingQuarters->SetExit("south", throneRoom);
+        
+        // Add hidden items to rooms
+        Room* kitchen = state.rooms[6].get();
+        kitchen->AddItem(Item("staff", "An ancient wooden staff, carved with mysterious runes. Its wood is dark with age.", true, ItemType::MISC, 0, 0));
+        
+        Room* basement = state.rooms[7].get();
+        basement->AddItem(Item("emerald", "A brilliant green emerald that seems to glow with inner light.", true, ItemType::MISC, 0, 0));
+        
+        chapel->AddItem(Item("diamond", "A flawless diamond that sparkles with pure, radiant light.", true, ItemType::MISC, 0, 0));
+        
+        sleepingQuarters->AddItem(Item("opal", "A shimmering opal that displays all colors of the rainbow.", true, ItemType::MISC, 0, 0));
+        
+        AddMessage("You hear distant rumbling and shifting sounds throughout the dungeon...");
+        AddMessage("New paths have opened!");
+    } else if (itemName == "?????" && state.staffComplete && !state.gameEnding) {
+        AddMessage("You raise the Ancient Staff of Power high above your head...");
+        AddMessage("The gems in the staff head begin to glow with intense magical energy!");
+        AddMessage("Suddenly, you hear a distant whistling sound from far above...");
+        AddMessage("The whistling grows louder and more intense...");
+        AddMessage("Something is dropping from the sky!");
+        AddMessage("");
+        AddMessage("The staff's power has torn a rift in the heavens themselves!");
+        AddMessage("A massive asteroid hurtles through the atmosphere toward the earth!");
+        AddMessage("You realize with horror what the staff's true power was...");
+        AddMessage("");
+        AddMessage("IMPACT!");
+        AddMessage("");
+        AddMessage("Type 'continue' to continue...");
+        
+        state.gameEnding = true;
+        state.waitingForContinue = true;
+    } else {
+        AddMessage("You can't use the " + itemName + ".");
+    }
+}
+
+void Simulation::AttackNearestMonster() {
+    if (!state.currentRoom) return;
+    
+    MonsterStore& monsters = state.monsters;
+    
+    // Find the closest living monster within attack range
+    size_t closest = monsters.FindNearest(state.currentRoom->GetId(), state.playerRoomX, state.playerRoomY, ATTACK_RANGE);
+    
+    if (closest != monsters.Size()) {
+        int damage = state.GetTotalAttack() + state.rng.NextInt(3) - 1; // Less variable damage
+        if (damage < 1) damage = 1;
+        
+        monsters.health[closest] -= damage;
+        monsters.isAggro[closest] = true;
+        
+        const std::string& name = monsters.name[closest].GetText();
+        AddMessage("You attack the " + name + " for " + std::to_string(damage) + " damage!");
+        
+        if (monsters.health[closest] <= 0) {
+            monsters.alive[closest] = false;
+            AddMessage("The " + name + " is defeated!");
+        } else {
+            AddMessage("The " + name + " has " + std::to_string(monsters.health[closest]) + " HP left.");
+        }
+    } else {
+        AddMessage("No monsters nearby to attack.");
+    }
+}
+
+void Simulation::TeleportToRoom(const std::string& roomName) {
+    if (recorder) recorder->RecordTeleport(state.tick, roomName);
+    
+    Room* targetRoom = state.FindRoom(Name::Find(roomName));
+    
+    if (targetRoom && targetRoom->IsVisited()) {
+        state.currentRoom = targetRoom;   
+        state.playerRoomX = 12.0f;
+        state.playerRoomY = 9.0f;
+        SnapInterpolation();
+        state.inMapView = false;
+        
+        AddMessage("*Magical energy swirls around you*");
+        AddMessage("You teleport to the " + roomName + "!");
+        AddMessage(state.currentRoom->GetName().GetText());
+        
+        // Show room description and exits
+        std::string fullDesc = state.currentRoom->GetDescription(state.monsters);
+        auto exits = state.currentRoom->GetExits();
+        if (!exits.empty()) {
+            fullDesc += "\n\nExits: ";
+            for (size_t i = 0; i < exits.size(); ++i) {
+                if (i > 0) fullDesc += ", ";
+                fullDesc += exits[i];
+            }
+        }
+        
+        // Add locked exits for armory
+        if (state.currentRoom->GetName() == ARMORY && !state.hasKey) {
+            if (!exits.empty()) {
+                fullDesc += ", east (locked)";
+            } else {
+                fullDesc += "\n\nExits: east (locked)";
+            }
+        }
+        
+        AddMessage(fullDesc);
+    }
+}
\ No newline at end of file
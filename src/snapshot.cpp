@@ -0,0 +1,369 @@
+#include "snapshot.h"
+#include "room_factory.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char SNAPSHOT_MAGIC[4] = {'R', 'D', 'S', 'V'};
+static const size_t HEADER_SIZE = 24;
+
+static uint32_t Fnv1a(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Appends little-endian fields to a byte buffer
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<uint8_t>& out) : out(out) {}
+    
+    void U8(uint8_t value) { out.push_back(value); }
+    void U32(uint32_t value) {
+        for (int i = 0; i < 4; i++) out.push_back((uint8_t)(value >> (i * 8)));
+    }
+    void U64(uint64_t value) {
+        for (int i = 0; i < 8; i++) out.push_back((uint8_t)(value >> (i * 8)));
+    }
+    void I32(int value) { U32((uint32_t)value); }
+    void F32(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        U32(bits);
+    }
+    void String(const std::string& text) {
+        U32((uint32_t)text.size());
+        out.insert(out.end(), text.begin(), text.end());
+    }
+    
+private:
+    std::vector<uint8_t>& out;
+};
+
+// Reads fields back from a byte span; any read past the end marks the whole read as failed
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t* data, size_t size) : data(data), size(size), pos(0), ok(true) {}
+    
+    bool Ok() const { return ok; }
+    bool AtEnd() const { return pos == size; }
+    size_t Remaining() const { return size - pos; }
+    
+    uint8_t U8() { return Has(1) ? data[pos++] : 0; }
+    uint32_t U32() {
+        if (!Has(4)) return 0;
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) value |= (uint32_t)data[pos++] << (i * 8);
+        return value;
+    }
+    uint64_t U64() {
+        if (!Has(8)) return 0;
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++) value |= (uint64_t)data[pos++] << (i * 8);
+        return value;
+    }
+    int I32() { return (int)U32(); }
+    float F32() {
+        uint32_t bits = U32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::string String() {
+        uint32_t length = U32();
+        if (!Has(length)) return "";
+        std::string text((const char*)data + pos, length);
+        pos += length;
+        return text;
+    }
+    
+private:
+    bool Has(size_t count) {
+        if (!ok || size - pos < count) {
+            ok = false;
+            return false;
+        }
+        return true;
+    }
+    
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool ok;
+};
+
+static void WriteItem(SnapshotWriter& out, const Item& item) {
+    out.String(item.name.GetText());
+    out.String(item.description);
+    out.U8(item.takeable);
+    out.U8((uint8_t)item.type);
+    out.I32(item.damageBonus);
+    out.I32(item.armorBonus);
+}
+
+static Item ReadItem(SnapshotReader& in) {
+    std::string name = in.String();
+    std::string description = in.String();
+    bool takeable = in.U8() != 0;
+    ItemType type = (ItemType)in.U8();
+    int damageBonus = in.I32();
+    int armorBonus = in.I32();
+    return Item(name, description, takeable, type, damageBonus, armorBonus);
+}
+
+static void WriteMonster(SnapshotWriter& out, const Monster& monster) {
+    out.String(monster.name.GetText());
+    out.String(monster.description);
+    out.I32(monster.health);
+    out.I32(monster.attack);
+    out.U8(monster.alive);
+    out.F32(monster.x);
+    out.F32(monster.y);
+    out.F32(monster.targetX);
+    out.F32(monster.targetY);
+    out.I32(monster.moveTicks);
+    out.F32(monster.aggroRange);
+    out.U8(monster.isAggro);
+}
+
+static Monster ReadMonster(SnapshotReader& in) {
+    std::string name = in.String();
+    std::string description = in.String();
+    int health = in.I32();
+    int attack = in.I32();
+    Monster monster(name, description, health, attack);
+    monster.alive = in.U8() != 0;
+    monster.x = monster.prevX = in.F32();
+    monster.y = monster.prevY = in.F32();
+    monster.targetX = in.F32();
+    monster.targetY = in.F32();
+    monster.moveTicks = in.I32();
+    monster.aggroRange = in.F32();
+    monster.isAggro = in.U8() != 0;
+    return monster;
+}
+
+// Quest and discovery flags, packed one bit each in this order
+static bool GameState::* const FLAGS[] = {
+    &GameState::isFemale, &GameState::isWalking, &GameState::bookTaken, &GameState::scrollTaken,
+    &GameState::mapUnlocked, &GameState::infirmaryRevealed, &GameState::inMapView, &GameState::hasKey,
+    &GameState::gemUsed, &GameState::hasTeleport, &GameState::strangeMet, &GameState::noteRead,
+    &GameState::hasStaff, &GameState::hasDiamond, &GameState::hasEmerald, &GameState::hasOpal,
+    &GameState::staffComplete, &GameState::gameEnding, &GameState::waitingForContinue
+};
+
+std::vector<uint8_t> Snapshot::Serialize(const GameState& state) {
+    std::vector<uint8_t> bytes(HEADER_SIZE);
+    SnapshotWriter out(bytes);
+    
+    out.U64(state.tick);
+    out.U64(state.lastMonsterAttackTick);
+    uint32_t rngState[4];
+    state.rng.GetState(rngState);
+    for (uint32_t word : rngState) out.U32(word);
+    
+    out.I32(state.playerHealth);
+    out.I32(state.basePlayerAttack);
+    out.I32(state.basePlayerArmor);
+    out.I32(state.equippedWeaponIndex);
+    out.I32(state.equippedArmorIndex);
+    out.F32(state.playerRoomX);
+    out.F32(state.playerRoomY);
+    out.F32(state.playerSpeed);
+    out.I32(state.moveTicks);
+    out.I32(state.walkAnimFrame);
+    out.I32(state.animTicks);
+    out.I32(state.endingPhase);
+    out.I32(state.endingTicks);
+    
+    uint32_t flags = 0;
+    for (size_t i = 0; i < sizeof(FLAGS) / sizeof(FLAGS[0]); i++) {
+        if (state.*FLAGS[i]) flags |= 1u << i;
+    }
+    out.U32(flags);
+    
+    out.I32(state.currentRoom ? state.currentRoom->GetId() : -1);
+    out.U32((uint32_t)state.inventory.size());
+    for (const auto& item : state.inventory) {
+        WriteItem(out, item);
+    }
+    
+    out.U32((uint32_t)state.rooms.size());
+    for (const auto& room : state.rooms) {
+        out.U8(room->IsVisited());
+        
+        std::vector<std::string> directions = room->GetExits();
+        out.U32((uint32_t)directions.size());
+        for (const auto& direction : directions) {
+            out.String(direction);
+            out.I32(room->GetExit(direction)->GetId());
+        }
+        
+        std::vector<Item> items = room->GetItems();
+        out.U32((uint32_t)items.size());
+        for (const auto& item : items) {
+            WriteItem(out, item);
+        }
+        
+        size_t firstMonster = state.monsters.RoomBegin(room->GetId());
+        size_t lastMonster = state.monsters.RoomEnd(room->GetId());
+        out.U32((uint32_t)(lastMonster - firstMonster));
+        for (size_t i = firstMonster; i < lastMonster; i++) {
+            WriteMonster(out, state.monsters.Get(i));
+        }
+    }
+    
+    // Header goes in last, once the payload size and checksum are known
+    uint32_t payloadSize = (uint32_t)(bytes.size() - HEADER_SIZE);
+    std::vector<uint8_t> header;
+    SnapshotWriter headerOut(header);
+    for (char c : SNAPSHOT_MAGIC) headerOut.U8((uint8_t)c);
+    headerOut.U32(VERSION);
+    headerOut.U64(state.rng.GetSeed());
+    headerOut.U32(payloadSize);
+    headerOut.U32(Fnv1a(bytes.data() + HEADER_SIZE, payloadSize));
+    std::copy(header.begin(), header.end(), bytes.begin());
+    return bytes;
+}
+
+bool Snapshot::Deserialize(GameState& state, const uint8_t* data, size_t size) {
+    if (size < HEADER_SIZE || std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        return false;
+    }
+    SnapshotReader header(data + 4, HEADER_SIZE - 4);
+    uint32_t version = header.U32();
+    uint64_t seed = header.U64();
+    uint32_t payloadSize = header.U32();
+    uint32_t checksum = header.U32();
+    if (version != VERSION || payloadSize != size - HEADER_SIZE || checksum != Fnv1a(data + HEADER_SIZE, payloadSize)) {
+        return false;
+    }
+    
+    GameState loaded;
+    SnapshotReader in(data + HEADER_SIZE, payloadSize);
+    loaded.tick = in.U64();
+    loaded.lastMonsterAttackTick = in.U64();
+    uint32_t rngState[4];
+    for (uint32_t& word : rngState) word = in.U32();
+    loaded.rng.SetState(seed, rngState);
+    
+    loaded.playerHealth = in.I32();
+    loaded.basePlayerAttack = in.I32();
+    loaded.basePlayerArmor = in.I32();
+    loaded.equippedWeaponIndex = in.I32();
+    loaded.equippedArmorIndex = in.I32();
+    loaded.playerRoomX = loaded.prevPlayerRoomX = in.F32();
+    loaded.playerRoomY = loaded.prevPlayerRoomY = in.F32();
+    loaded.playerSpeed = in.F32();
+    loaded.moveTicks = in.I32();
+    loaded.walkAnimFrame = in.I32();
+    loaded.animTicks = in.I32();
+    loaded.endingPhase = in.I32();
+    loaded.endingTicks = in.I32();
+    
+    uint32_t flags = in.U32();
+    for (size_t i = 0; i < sizeof(FLAGS) / sizeof(FLAGS[0]); i++) {
+        loaded.*FLAGS[i] = (flags >> i) & 1u;
+    }
+    
+    int currentRoomIndex = in.I32();
+    uint32_t inventoryCount = in.U32();
+    for (uint32_t i = 0; i < inventoryCount && in.Ok(); i++) {
+        loaded.inventory.push_back(ReadItem(in));
+    }
+    
+    // Every saved room takes at least its visited flag and three counts, so a room count
+    // the rest of the payload can't hold is corrupt, and mustn't get as far as generating
+    const uint32_t MIN_ROOM_BYTES = 13;
+    
+    // Rebuild the rooms from the seed so their themes match the saved game, then
+    // replace everything that can change during play with the saved contents. Any rooms
+    // past the story ones are the generated Depths, which the seed also determines.
+    uint32_t roomCount = in.U32();
+    if (!in.Ok() || roomCount < (uint32_t)RoomFactory::STORY_ROOM_COUNT || roomCount > in.Remaining() / MIN_ROOM_BYTES) {
+        return false;
+    }
+    Rng themeRng(seed);
+    loaded.rooms = RoomFactory::CreateAllRooms(themeRng, (int)(roomCount - RoomFactory::STORY_ROOM_COUNT));
+    loaded.IndexRooms();
+    for (auto& room : loaded.rooms) {
+        room->ClearContents();
+        room->SetVisited(in.U8() != 0);
+        
+        uint32_t exitCount = in.U32();
+        for (uint32_t i = 0; i < exitCount && in.Ok(); i++) {
+            std::string direction = in.String();
+            int target = in.I32();
+            if (target < 0 || target >= (int)loaded.rooms.size()) return false;
+            room->SetExit(direction, loaded.rooms[target].get());
+        }
+        
+        uint32_t itemCount = in.U32();
+        for (uint32_t i = 0; i < itemCount && in.Ok(); i++) {
+            room->AddItem(ReadItem(in));
+        }
+        
+        uint32_t monsterCount = in.U32();
+        for (uint32_t i = 0; i < monsterCount && in.Ok(); i++) {
+            room->AddMonster(ReadMonster(in));
+        }
+    }
+    
+    loaded.monsters.Build(loaded.rooms);
+    
+    if (!in.Ok() || !in.AtEnd() || currentRoomIndex < 0 || currentRoomIndex >= (int)loaded.rooms.size()) {
+        return false;
+    }
+    loaded.currentRoom = loaded.rooms[currentRoomIndex].get();
+    
+    state = std::move(loaded);
+    return true;
+}
+
+bool Snapshot::Save(const GameState& state, const std::string& path) {
+    std::vector<uint8_t> bytes = Serialize(state);
+    
+    // Written beside the old save and renamed over it only once complete, so a full disk
+    // or a crash mid-write leaves the previous save as it was
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write((const char*)bytes.data(), bytes.size());
+    file.close();
+    if (!file || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::Load(GameState& state, const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+    // Decode straight out of the page cache rather than copying the file first
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    
+    struct stat info;
+    bool loaded = false;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            loaded = Deserialize(state, (const uint8_t*)mapped, info.st_size);
+            munmap(mapped, info.st_size);
+        }
+    }
+    close(fd);
+    return loaded;
+#else
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return !bytes.empty() && Deserialize(state, bytes.data(), bytes.size());
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "tokenizer.h"
+
+const std::vector<std::string_view>& Tokenizer::Split(std::string_view text, char delimiter) {
+    tokens.clear();
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t next = text.find(delimiter, pos);
+        if (next == std::string_view::npos) next = text.size();
+        if (next > pos) {
+            tokens.push_back(text.substr(pos, next - pos));
+        }
+        pos = next + 1;
+    }
+    return tokens;
+}
+
+const std::vector<std::string_view>& Tokenizer::SplitLower(std::string_view text, char delimiter) {
+    lowered.assign(text);
+    for (char& c : lowered) {
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    }
+    return Split(lowered, delimiter);
+}
\ No newline at end of file
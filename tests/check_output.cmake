@@ -0,0 +1,8 @@
+# Runs COMMAND (a ;-list) and fails unless what it prints on stdout matches EXPECTED
+# byte for byte. Used by ctest for the runs whose whole output is the check.
+#   cmake -DCOMMAND=... -DEXPECTED=file -P check_output.cmake
+execute_process(COMMAND ${COMMAND} OUTPUT_VARIABLE actual ERROR_QUIET)
+file(READ ${EXPECTED} expected)
+if(NOT actual STREQUAL expected)
+    message(FATAL_ERROR "Output differs from ${EXPECTED}:\n${actual}")
+endif()
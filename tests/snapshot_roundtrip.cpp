@@ -0,0 +1,87 @@
+#include "simulation.h"
+#include "snapshot.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Plays into the middle of a fight, saves, loads the file into a second simulation and
+// checks that both hold the same state, then that they stay identical for another ten
+// seconds of play. A damaged file has to be refused without touching the state.
+//   snapshot_roundtrip [path]
+
+static const uint64_t SEED = 3;
+static const int DEPTH_ROOMS = 20;
+
+static void RunTicks(Simulation& simulation, int ticks, const TickInput& input) {
+    for (int i = 0; i < ticks; i++) {
+        simulation.Tick(input);
+    }
+}
+
+// Swings every half second, so monsters keep fighting back across the save
+static void Fight(Simulation& simulation, int ticks) {
+    TickInput attack;
+    attack.attack = true;
+    for (int i = 0; i < ticks; i += Simulation::TICK_RATE / 2) {
+        simulation.Tick(attack);
+        RunTicks(simulation, Simulation::TICK_RATE / 2 - 1, TickInput());
+    }
+}
+
+static bool Check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "snapshot_roundtrip: " << what << std::endl;
+    }
+    return condition;
+}
+
+int main(int argc, char** argv) {
+    std::error_code error;
+    std::string path = argc > 1 ? argv[1] : (std::filesystem::temp_directory_path(error) / "snapshot_roundtrip.rds").string();
+    
+    Simulation played("", SEED, DEPTH_ROOMS);
+    for (const char* command : {"male", "go west", "take book", "take scroll", "go east", "go north"}) {
+        played.SubmitCommand(command);
+        played.Tick(TickInput());
+    }
+    TickInput right;
+    right.right = true;
+    RunTicks(played, 15, right);
+    Fight(played, 2 * Simulation::TICK_RATE);
+    
+    if (!Check(played.SaveSnapshot(path), "save failed")) return 1;
+    std::vector<uint8_t> saved = Snapshot::Serialize(played.GetState());
+    
+    Simulation loaded("", SEED, DEPTH_ROOMS);
+    bool ok = Check(loaded.LoadSnapshot(path), "load failed") &&
+              Check(Snapshot::Serialize(loaded.GetState()) == saved, "loaded state differs from the saved one");
+    
+    if (ok) {
+        Fight(played, 10 * Simulation::TICK_RATE);
+        Fight(loaded, 10 * Simulation::TICK_RATE);
+        ok = Check(Snapshot::Serialize(loaded.GetState()) == Snapshot::Serialize(played.GetState()), "loaded game played out differently");
+    }
+    
+    if (ok) {
+        // One flipped bit near the end of the payload, past the header
+        std::vector<char> bytes((size_t)std::filesystem::file_size(path, error));
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(bytes.data(), (std::streamsize)bytes.size());
+        bytes[bytes.size() - 2] ^= 0x10;
+        file.seekp(0);
+        file.write(bytes.data(), (std::streamsize)bytes.size());
+        file.close();
+        
+        std::vector<uint8_t> before = Snapshot::Serialize(loaded.GetState());
+        ok = Check(!loaded.LoadSnapshot(path), "damaged snapshot was accepted") &&
+             Check(Snapshot::Serialize(loaded.GetState()) == before, "damaged snapshot changed the state");
+    }
+    
+    std::remove(path.c_str());
+    if (!ok) return 1;
+    std::cout << "snapshot round trip: " << saved.size() << " bytes, health " << played.GetState().playerHealth << std::endl;
+    return 0;
+}
\ No newline at end of file